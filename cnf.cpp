@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <charconv>
+#include <vector>
+
+#include "include/cnf.h"
+
+namespace factor
+{
+    static std::optional<line_error> fail(
+        size_t a_line,
+        size_t a_position,
+        std::string_view a_message
+    )
+    {
+        return line_error{ a_line, { a_position, a_message } };
+    }
+
+    template<typename INTEGER>
+    static bool parse_integer(
+        std::string_view a_word,
+        INTEGER& a_value
+    )
+    {
+        const auto [l_next, l_error] = std::from_chars(a_word.data(), a_word.data() + a_word.size(), a_value);
+
+        return !a_word.empty() && l_error == std::errc() && l_next == a_word.data() + a_word.size();
+
+    }
+
+    std::optional<line_error> read_dimacs(
+        std::istream& a_istream,
+        cnf& a_cnf,
+        size_t a_buffer_bytes
+    )
+    {
+        a_cnf = cnf{ 0 };
+
+        line_reader l_lines(a_istream, a_buffer_bytes);
+
+        bool l_header = false;
+
+        /// The clause being read, which may span lines.
+        std::vector<std::pair<uint32_t, bool>> l_clause;
+
+        for (std::string_view l_line; l_lines.next(l_line);)
+        {
+            const size_t l_line_index = l_lines.lines() - 1;
+
+            size_t l_position = 0;
+
+            std::string_view l_word = next_word(l_line, l_position);
+
+            const auto l_word_position = [&] { return size_t(l_word.data() - l_line.data()); };
+
+            if (l_word.empty() || l_word[0] == 'c')
+                continue;
+
+            if (l_word[0] == '%')
+                break;
+
+            if (l_word == "p")
+            {
+                if (l_header)
+                    return fail(l_line_index, l_word_position(), "repeated problem line");
+
+                if (l_word = next_word(l_line, l_position); l_word != "cnf")
+                    return fail(l_line_index, l_word_position(), "expected \"cnf\"");
+
+                uint32_t l_clauses = 0;
+
+                if (l_word = next_word(l_line, l_position); !parse_integer(l_word, a_cnf.m_variables))
+                    return fail(l_line_index, l_word_position(), "expected a variable count");
+
+                if (l_word = next_word(l_line, l_position); !parse_integer(l_word, l_clauses))
+                    return fail(l_line_index, l_word_position(), "expected a clause count");
+
+                /// The count is often inaccurate, so is
+                ///     trusted only up to a bound.
+                a_cnf.m_clauses.reserve(std::min<uint32_t>(l_clauses, CNF_RESERVED_CLAUSES));
+
+                l_header = true;
+
+                continue;
+
+            }
+
+            if (!l_header)
+                return fail(l_line_index, l_word_position(), "clause precedes the problem line");
+
+            for (; !l_word.empty(); l_word = next_word(l_line, l_position))
+            {
+                int64_t l_literal = 0;
+
+                if (!parse_integer(l_word, l_literal))
+                    return fail(l_line_index, l_word_position(), "expected a literal");
+
+                if (l_literal == 0)
+                {
+                    a_cnf.m_clauses.push_back(std::move(l_clause));
+                    l_clause.clear();
+                    continue;
+                }
+
+                const uint64_t l_variable = l_literal < 0 ? -uint64_t(l_literal) : uint64_t(l_literal);
+
+                if (l_variable > a_cnf.m_variables)
+                    return fail(l_line_index, l_word_position(), "variable exceeds the declared count");
+
+                l_clause.emplace_back(uint32_t(l_variable - 1), l_literal > 0);
+
+            }
+
+        }
+
+        if (!l_header)
+            return fail(l_lines.lines(), 0, "missing problem line");
+
+        if (!l_clause.empty())
+            a_cnf.m_clauses.push_back(std::move(l_clause));
+
+        return std::nullopt;
+
+    }
+
+    /// Returns the number of nodes reachable from a_node,
+    ///     excluding the constants.
+    static size_t count_nodes(
+        const node* a_node
+    )
+    {
+        const uint32_t l_epoch = global_node_sink::bound()->next_epoch();
+
+        size_t l_count = 0;
+
+        std::vector<const node*> l_pending = { a_node };
+
+        while (!l_pending.empty())
+        {
+            const node* l_node = l_pending.back();
+
+            l_pending.pop_back();
+
+            if (l_node == ZERO || l_node == ONE || !l_node->mark(l_epoch))
+                continue;
+
+            l_count++;
+
+            l_pending.push_back(l_node->negative());
+            l_pending.push_back(l_node->positive());
+
+        }
+
+        return l_count;
+
+    }
+
+    const node* conjoin_clauses(
+        const cnf& a_cnf,
+        conjunction_statistics& a_statistics,
+        conjunction_schedule a_schedule
+    )
+    {
+        const auto l_start = std::chrono::steady_clock::now();
+
+        a_statistics = { 0, 0, 0, {} };
+
+        /// Counting the products is not part of the
+        ///     schedule, so is kept out of m_elapsed.
+        std::chrono::steady_clock::duration l_counting{};
+
+        const auto l_conjoin = [&](const node* a_x, const node* a_y)
+        {
+            const node* l_result = logic::conjoin(a_x, a_y);
+
+            const auto l_counting_start = std::chrono::steady_clock::now();
+
+            a_statistics.m_conjunctions++;
+            a_statistics.m_peak_product_nodes = std::max(a_statistics.m_peak_product_nodes, count_nodes(l_result));
+
+            l_counting += std::chrono::steady_clock::now() - l_counting_start;
+
+            return l_result;
+        };
+
+        const node* l_product = ONE;
+
+        if (a_schedule == FILE_ORDER)
+        {
+            for (size_t i = 0; i < a_cnf.m_clauses.size() && l_product != ZERO; i++)
+                l_product = l_conjoin(l_product, clause(a_cnf.m_clauses[i]));
+        }
+        else
+        {
+            /// The declared variable count may far exceed the
+            ///     variables used, so only those get buckets.
+            uint32_t l_variables = 0;
+
+            for (const std::vector<std::pair<uint32_t, bool>>& l_literals : a_cnf.m_clauses)
+                for (const auto& [l_variable_index, l_sign] : l_literals)
+                    l_variables = std::max(l_variables, l_variable_index + 1);
+
+            /// A clause's root is its first variable.
+            std::vector<std::vector<const node*>> l_buckets(l_variables);
+
+            for (const std::vector<std::pair<uint32_t, bool>>& l_literals : a_cnf.m_clauses)
+            {
+                const node* l_clause = clause(l_literals);
+
+                if (l_clause == ZERO)
+                    l_product = ZERO;
+                else if (l_clause != ONE)
+                    l_buckets[l_clause->depth()].push_back(l_clause);
+            }
+
+            for (size_t k = l_buckets.size(); k-- > 0 && l_product != ZERO;)
+            {
+                std::vector<const node*>& l_bucket = l_buckets[k];
+
+                if (l_bucket.empty())
+                    continue;
+
+                l_bucket.push_back(l_product);
+
+                /// Pairs are conjoined level by level, so each
+                ///     clause takes part in logarithmically
+                ///     many conjunctions.
+                while (l_bucket.size() > 1)
+                {
+                    size_t l_kept = 0;
+
+                    for (size_t i = 0; i < l_bucket.size(); i += 2)
+                        l_bucket[l_kept++] = i + 1 < l_bucket.size() ? l_conjoin(l_bucket[i], l_bucket[i + 1]) : l_bucket[i];
+
+                    l_bucket.resize(l_kept);
+
+                }
+
+                l_product = l_bucket.front();
+
+            }
+        }
+
+        a_statistics.m_dag_nodes = global_node_sink::bound()->size();
+        a_statistics.m_elapsed = std::chrono::steady_clock::now() - l_start - l_counting;
+
+        return l_product;
+
+    }
+
+}
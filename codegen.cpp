@@ -0,0 +1,243 @@
+#include <assert.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "include/codegen.h"
+
+namespace factor
+{
+    /// Counts, for each reachable node, the number of
+    ///     edges entering it, recording the nodes in
+    ///     post-order (children before parents).
+    static void count_fan_in(
+        std::map<const node*, uint32_t>& a_fan_in,
+        std::vector<const node*>& a_post_order,
+        std::set<uint32_t>& a_support,
+        const node* a_node
+    )
+    {
+        if (a_node == ZERO || a_node == ONE)
+            return;
+
+        /// Only descend on the first visit.
+        if (a_fan_in[a_node]++ > 0)
+            return;
+
+        a_support.insert(a_node->depth());
+
+        count_fan_in(a_fan_in, a_post_order, a_support, a_node->negative());
+        count_fan_in(a_fan_in, a_post_order, a_support, a_node->positive());
+
+        a_post_order.push_back(a_node);
+
+    }
+
+    /// Emits the expression selecting the argued variable's bit.
+    static void generate_bit(
+        std::ostream& a_ostream,
+        uint32_t a_variable_index
+    )
+    {
+        a_ostream
+            << "(x[" << a_variable_index / 64 << "] >> "
+            << a_variable_index % 64 << " & 1)";
+    }
+
+    static void generate_expression(
+        std::ostream& a_ostream,
+        const std::map<const node*, uint32_t>& a_helpers,
+        std::string_view a_name,
+        const node* a_node,
+        bool a_inline
+    )
+    {
+        if (a_node == ZERO)
+        {
+            a_ostream << "false";
+            return;
+        }
+
+        if (a_node == ONE)
+        {
+            a_ostream << "true";
+            return;
+        }
+
+        /// Shared nodes are referenced by call, unless
+        ///     this is the body of their own helper.
+        if (!a_inline && a_helpers.contains(a_node))
+        {
+            a_ostream << a_name << "_" << a_helpers.at(a_node) << "(x)";
+            return;
+        }
+
+        const node* l_negative = a_node->negative();
+        const node* l_positive = a_node->positive();
+
+        /// Literals need no conditional at all.
+        if (l_negative == ZERO && l_positive == ONE)
+        {
+            generate_bit(a_ostream, a_node->depth());
+            return;
+        }
+
+        if (l_negative == ONE && l_positive == ZERO)
+        {
+            a_ostream << "!";
+            generate_bit(a_ostream, a_node->depth());
+            return;
+        }
+
+        a_ostream << "(";
+
+        /// With a terminal child, the node reduces to a
+        ///     conjunction or disjunction with the literal:
+        ///     x ? f : 0 is x && f, and x ? f : 1 is !x || f.
+        if (l_negative == ZERO || l_negative == ONE)
+        {
+            a_ostream << (l_negative == ZERO ? "" : "!");
+            generate_bit(a_ostream, a_node->depth());
+            a_ostream << (l_negative == ZERO ? " && " : " || ");
+            generate_expression(a_ostream, a_helpers, a_name, l_positive, false);
+        }
+        else if (l_positive == ZERO || l_positive == ONE)
+        {
+            a_ostream << (l_positive == ZERO ? "!" : "");
+            generate_bit(a_ostream, a_node->depth());
+            a_ostream << (l_positive == ZERO ? " && " : " || ");
+            generate_expression(a_ostream, a_helpers, a_name, l_negative, false);
+        }
+        else
+        {
+            generate_bit(a_ostream, a_node->depth());
+            a_ostream << " ? ";
+            generate_expression(a_ostream, a_helpers, a_name, l_positive, false);
+            a_ostream << " : ";
+            generate_expression(a_ostream, a_helpers, a_name, l_negative, false);
+        }
+
+        a_ostream << ")";
+
+    }
+
+    static void generate_table(
+        std::ostream& a_ostream,
+        const node* a_root,
+        std::string_view a_name,
+        const std::set<uint32_t>& a_support
+    )
+    {
+        const std::vector<uint32_t> l_support(a_support.begin(), a_support.end());
+
+        assert(l_support.size() <= 6);
+
+        /// Tabulate the function over its support.
+        uint64_t l_table = 0;
+
+        std::vector<bool> l_input(l_support.empty() ? 0 : l_support.back() + 1);
+
+        for (uint32_t i = 0; i < (1U << l_support.size()); i++)
+        {
+            for (uint32_t k = 0; k < l_support.size(); k++)
+                l_input[l_support[k]] = (i >> k) & 1;
+
+            if (evaluate(a_root, l_input))
+                l_table |= 1ULL << i;
+        }
+
+        std::ios_base::fmtflags l_flags = a_ostream.flags();
+
+        a_ostream
+            << "bool " << a_name << "(const uint64_t* x)\n"
+            << "{\n"
+            << "    constexpr uint64_t TABLE = 0x" << std::hex << l_table << std::dec << "ULL;\n";
+
+        a_ostream.flags(l_flags);
+
+        a_ostream << "    const unsigned i = 0";
+
+        for (uint32_t k = 0; k < l_support.size(); k++)
+        {
+            a_ostream << " | ";
+            generate_bit(a_ostream, l_support[k]);
+            a_ostream << " << " << k;
+        }
+
+        a_ostream
+            << ";\n"
+            << "    return TABLE >> i & 1;\n"
+            << "}\n";
+
+    }
+
+    std::ostream& generate_cpp(
+        std::ostream& a_ostream,
+        const node* a_root,
+        std::string_view a_name,
+        uint32_t a_table_support
+    )
+    {
+        std::map<const node*, uint32_t> l_fan_in;
+        std::vector<const node*> l_post_order;
+        std::set<uint32_t> l_support;
+
+        count_fan_in(l_fan_in, l_post_order, l_support, a_root);
+
+        a_ostream << "#include <stdint.h>\n\n";
+
+        /// One 64-bit table holds at most six variables.
+        if (l_support.size() <= std::min<uint32_t>(a_table_support, 6))
+        {
+            generate_table(a_ostream, a_root, a_name, l_support);
+            return a_ostream;
+        }
+
+        /// Give each shared node a helper, numbered such
+        ///     that helpers are defined before their use.
+        std::map<const node*, uint32_t> l_helpers;
+
+        for (const node* l_node : l_post_order)
+        {
+            if (l_node == a_root || l_fan_in[l_node] < 2)
+                continue;
+
+            /// Literals are cheaper inline than called.
+            if ((l_node->negative() == ZERO || l_node->negative() == ONE) &&
+                (l_node->positive() == ZERO || l_node->positive() == ONE))
+                continue;
+
+            const uint32_t l_helper = l_helpers.size();
+
+            l_helpers[l_node] = l_helper;
+
+            a_ostream
+                << "static inline bool " << a_name << "_" << l_helper << "(const uint64_t* x)\n"
+                << "{\n"
+                << "    return ";
+
+            generate_expression(a_ostream, l_helpers, a_name, l_node, true);
+
+            a_ostream
+                << ";\n"
+                << "}\n\n";
+
+        }
+
+        a_ostream
+            << "bool " << a_name << "(const uint64_t* x)\n"
+            << "{\n"
+            << "    return ";
+
+        generate_expression(a_ostream, l_helpers, a_name, a_root, true);
+
+        a_ostream
+            << ";\n"
+            << "}\n";
+
+        return a_ostream;
+
+    }
+
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <vector>
+
+#include "include/dot.h"
+
+namespace factor
+{
+    /// Writes the identifier of the argued node, which is
+    ///     constant, elided if at or past a_end_depth, or
+    ///     otherwise named by its address.
+    static void write_identifier(
+        std::ostream& a_ostream,
+        const node* a_node,
+        uint64_t a_end_depth
+    )
+    {
+        if (a_node == ZERO)
+            a_ostream << "zero";
+        else if (a_node == ONE)
+            a_ostream << "one";
+        else if (a_node->depth() >= a_end_depth)
+            a_ostream << "elided";
+        else
+            a_ostream << "n" << static_cast<const void*>(a_node);
+    }
+
+    std::ostream& write_dot(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots,
+        uint32_t a_levels
+    )
+    {
+        dag* l_dag = global_node_sink::bound();
+
+        const uint32_t l_epoch = l_dag->next_epoch();
+
+        uint32_t l_first_depth = UINT32_MAX;
+
+        for (const node* l_root : a_roots)
+            if (l_root != ZERO && l_root != ONE)
+                l_first_depth = std::min(l_first_depth, l_root->depth());
+
+        /// Defines the depth past the last variable written.
+        const uint64_t l_end_depth = uint64_t(l_first_depth) + a_levels;
+
+        a_ostream << "digraph dag {\n";
+
+        /// The terminals and the elision are written whether
+        ///     or not they are reached, and sit below the rest.
+        a_ostream
+            << "  { rank=sink; zero [shape=box,label=\"0\"]; one [shape=box,label=\"1\"]; "
+            << "elided [shape=plaintext,label=\"...\"]; }\n";
+
+        std::vector<const node*> l_pending;
+
+        for (size_t i = 0; i < a_roots.size(); i++)
+        {
+            a_ostream << "  r" << i << " [shape=plaintext,label=\"" << i << "\"];\n  r" << i << " -> ";
+            write_identifier(a_ostream, a_roots[i], l_end_depth);
+            a_ostream << ";\n";
+
+            l_pending.push_back(a_roots[i]);
+        }
+
+        while (!l_pending.empty())
+        {
+            const node* l_node = l_pending.back();
+
+            l_pending.pop_back();
+
+            if (l_node == ZERO || l_node == ONE || l_node->depth() >= l_end_depth || !l_node->mark(l_epoch))
+                continue;
+
+            /// Subgraphs of the same name are one subgraph, so
+            ///     each level is built up a node at a time.
+            a_ostream << "  subgraph level_" << l_node->depth() << " { rank=same; ";
+            write_identifier(a_ostream, l_node, l_end_depth);
+            a_ostream << " [label=\"";
+
+            const std::string_view l_name = l_dag->symbols().name(l_node->depth());
+
+            if (l_name.empty())
+                a_ostream << "[" << l_node->depth() << "]";
+            else
+                a_ostream << l_name;
+
+            a_ostream << "\"]; }\n";
+
+            a_ostream << "  ";
+            write_identifier(a_ostream, l_node, l_end_depth);
+            a_ostream << " -> ";
+            write_identifier(a_ostream, l_node->negative(), l_end_depth);
+            a_ostream << " [style=dashed];\n";
+
+            a_ostream << "  ";
+            write_identifier(a_ostream, l_node, l_end_depth);
+            a_ostream << " -> ";
+            write_identifier(a_ostream, l_node->positive(), l_end_depth);
+            a_ostream << ";\n";
+
+            l_pending.push_back(l_node->positive());
+            l_pending.push_back(l_node->negative());
+
+        }
+
+        a_ostream << "}\n";
+
+        return a_ostream;
+
+    }
+
+}
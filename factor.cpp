@@ -4,14 +4,72 @@
 
 namespace factor
 {
-    std::ostream& operator<<(
+    /// Writes the argued variable by name if it has one
+    ///     in the argued table, and as [index] otherwise.
+    ///     Returns whether it was written by name.
+    static bool print_variable(
         std::ostream& a_ostream,
-        const node* a_node
+        uint32_t a_variable_index,
+        const symbol_table* a_symbols
+    )
+    {
+        const std::string_view l_name = a_symbols ? a_symbols->name(a_variable_index) : std::string_view();
+
+        if (l_name.empty())
+        {
+            a_ostream << "[" << a_variable_index << "]";
+            return false;
+        }
+
+        a_ostream << l_name;
+
+        return true;
+
+    }
+
+    /// Maps each shared node to the index of its definition.
+    using definitions = std::unordered_map<const node*, uint32_t>;
+
+    static void print(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table* a_symbols,
+        const definitions* a_definitions
+    );
+
+    /// Prints a child, by reference if it has been defined.
+    static void print_operand(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table* a_symbols,
+        const definitions* a_definitions
+    )
+    {
+        if (a_definitions)
+        {
+            const auto l_definition = a_definitions->find(a_node);
+
+            if (l_definition != a_definitions->end())
+            {
+                a_ostream << "$" << l_definition->second;
+                return;
+            }
+        }
+
+        print(a_ostream, a_node, a_symbols, a_definitions);
+
+    }
+
+    static void print(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table* a_symbols,
+        const definitions* a_definitions
     )
     {
         /// Do not print base cases.
         if (a_node == ZERO || a_node == ONE)
-            return a_ostream;
+            return;
 
         /// Only print bounding parens if BOTH children
         ///     are non-zero quantities.
@@ -20,7 +78,11 @@ namespace factor
 
         /// Negative case. Print an apostrophe to indicate.
         if (a_node->negative() != ZERO)
-            a_ostream << "[" << a_node->depth() << "]'" << a_node->negative();
+        {
+            print_variable(a_ostream, a_node->depth(), a_symbols);
+            a_ostream << "'";
+            print_operand(a_ostream, a_node->negative(), a_symbols, a_definitions);
+        }
 
         /// Only print disjunction if BOTH children
         ///     are non-zero quantities.
@@ -29,14 +91,130 @@ namespace factor
 
         /// Positive case. Omit apostrophe to indicate.
         if (a_node->positive() != ZERO)
-            a_ostream << "[" << a_node->depth() << "]" << a_node->positive();
+        {
+            /// A name directly followed by another name or
+            ///     an index would read back as one name.
+            if (print_variable(a_ostream, a_node->depth(), a_symbols) && a_node->positive() != ONE)
+                a_ostream << " ";
+
+            print_operand(a_ostream, a_node->positive(), a_symbols, a_definitions);
+        }
 
         /// Closing paren.
         if (a_node->negative() != ZERO && a_node->positive() != ZERO)
             a_ostream << ")";
-        
+
+    }
+
+    std::ostream& operator<<(
+        std::ostream& a_ostream,
+        const node* a_node
+    )
+    {
+        print(a_ostream, a_node, nullptr, nullptr);
+        return a_ostream;
+    }
+
+    std::ostream& print(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table& a_symbols
+    )
+    {
+        print(a_ostream, a_node, &a_symbols, nullptr);
+        return a_ostream;
+    }
+
+    /// Counts the parents of each node reachable from a_node
+    ///     into a_fan_in, visiting each node once.
+    static void count_fan_in(
+        const node* a_node,
+        std::unordered_map<const node*, uint32_t>& a_fan_in
+    )
+    {
+        for (const node* l_child : { a_node->negative(), a_node->positive() })
+        {
+            if (l_child == ZERO || l_child == ONE)
+                continue;
+
+            if (a_fan_in[l_child]++ == 0)
+                count_fan_in(l_child, a_fan_in);
+        }
+    }
+
+    /// Defines the shared nodes beneath a_node, other than
+    ///     those already defined, children before parents.
+    static void define_shared(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table* a_symbols,
+        const std::unordered_map<const node*, uint32_t>& a_fan_in,
+        definitions& a_definitions
+    )
+    {
+        for (const node* l_child : { a_node->negative(), a_node->positive() })
+        {
+            if (l_child == ZERO || l_child == ONE || a_definitions.contains(l_child))
+                continue;
+
+            define_shared(a_ostream, l_child, a_symbols, a_fan_in, a_definitions);
+
+            if (a_fan_in.at(l_child) < 2)
+                continue;
+
+            const uint32_t l_index = a_definitions.size();
+
+            a_ostream << "$" << l_index << " = ";
+            print(a_ostream, l_child, a_symbols, &a_definitions);
+            a_ostream << "\n";
+
+            a_definitions.emplace(l_child, l_index);
+
+        }
+    }
+
+    static void print_shared(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table* a_symbols
+    )
+    {
+        /// The tree form writes nothing for a constant, which
+        ///     would read back as ONE.
+        if (a_node == ZERO || a_node == ONE)
+        {
+            a_ostream << (a_node == ONE ? "()\n" : "()'\n");
+            return;
+        }
+
+        std::unordered_map<const node*, uint32_t> l_fan_in;
+        definitions l_definitions;
+
+        count_fan_in(a_node, l_fan_in);
+        define_shared(a_ostream, a_node, a_symbols, l_fan_in, l_definitions);
+
+        print(a_ostream, a_node, a_symbols, &l_definitions);
+        a_ostream << "\n";
+
+    }
+
+    std::ostream& print_shared(
+        std::ostream& a_ostream,
+        const node* a_node
+    )
+    {
+        print_shared(a_ostream, a_node, nullptr);
+        return a_ostream;
+    }
+
+    std::ostream& print_shared(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table& a_symbols
+    )
+    {
+        print_shared(a_ostream, a_node, &a_symbols);
         return a_ostream;
-        
     }
 
     std::istream& operator>>(
@@ -121,6 +299,6 @@ namespace factor
         
     }
 
-    dag* global_node_sink::s_graph(nullptr);
+    thread_local dag* global_node_sink::s_graph(nullptr);
 
 }
@@ -0,0 +1,281 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include "include/frozen.h"
+
+namespace factor
+{
+    static constexpr char FROZEN_MAGIC[8] = { 'F', 'D', 'A', 'G', 'F', 'R', 'Z', 'N' };
+    static constexpr uint32_t FROZEN_VERSION = 1;
+    static constexpr uint32_t FROZEN_BYTE_ORDER = 0x01020304;
+
+    /// Defines the size of the chunks in which
+    ///     frozen dags are written.
+    static constexpr size_t FROZEN_BUFFER_BYTES = size_t(1) << 20;
+
+    static uint64_t align(
+        uint64_t a_offset
+    )
+    {
+        return (a_offset + FROZEN_ALIGNMENT - 1) / FROZEN_ALIGNMENT * FROZEN_ALIGNMENT;
+    }
+
+    void frozen_dag::close(
+
+    )
+    {
+        if (m_map)
+            munmap(m_map, m_map_size);
+
+        m_map = nullptr;
+        m_map_size = 0;
+        m_header = nullptr;
+        m_records = nullptr;
+        m_roots = nullptr;
+    }
+
+    std::optional<parse_error> frozen_dag::open(
+        const char* a_path
+    )
+    {
+        close();
+
+        const int l_file = ::open(a_path, O_RDONLY);
+
+        if (l_file < 0)
+            throw std::system_error(errno, std::generic_category(), a_path);
+
+        struct stat l_stat;
+
+        if (fstat(l_file, &l_stat) != 0)
+        {
+            const int l_errno = errno;
+            ::close(l_file);
+            throw std::system_error(l_errno, std::generic_category(), a_path);
+        }
+
+        const size_t l_size = l_stat.st_size;
+
+        if (l_size < sizeof(frozen_header))
+        {
+            ::close(l_file);
+            return parse_error{ l_size, "truncated header" };
+        }
+
+        void* l_map = mmap(nullptr, l_size, PROT_READ, MAP_SHARED, l_file, 0);
+
+        const int l_errno = errno;
+
+        /// The mapping outlives the descriptor.
+        ::close(l_file);
+
+        if (l_map == MAP_FAILED)
+            throw std::system_error(l_errno, std::generic_category(), a_path);
+
+        /// Evaluation follows one path down the records,
+        ///     which read-ahead would mostly waste.
+        madvise(l_map, l_size, MADV_RANDOM);
+
+        m_map = l_map;
+        m_map_size = l_size;
+
+        const frozen_header& l_header = *static_cast<const frozen_header*>(l_map);
+
+        const auto l_fail = [&](size_t a_position, std::string_view a_message)
+        {
+            close();
+            return parse_error{ a_position, a_message };
+        };
+
+        if (std::memcmp(l_header.m_magic, FROZEN_MAGIC, sizeof(FROZEN_MAGIC)) != 0)
+            return l_fail(offsetof(frozen_header, m_magic), "expected \"FDAGFRZN\"");
+
+        if (l_header.m_version != FROZEN_VERSION)
+            return l_fail(offsetof(frozen_header, m_version), "unsupported version");
+
+        if (l_header.m_byte_order != FROZEN_BYTE_ORDER)
+            return l_fail(offsetof(frozen_header, m_byte_order), "written in another byte order");
+
+        if (l_header.m_nodes >= UINT32_MAX - 1)
+            return l_fail(offsetof(frozen_header, m_nodes), "too many nodes");
+
+        /// Counts are bounded by the file size before they are
+        ///     multiplied, so the section ends cannot overflow.
+        if (l_header.m_records_offset % FROZEN_ALIGNMENT != 0 || l_header.m_records_offset < sizeof(frozen_header) ||
+            l_header.m_records_offset > l_size ||
+            l_header.m_nodes > (l_size - l_header.m_records_offset) / sizeof(frozen_record))
+            return l_fail(offsetof(frozen_header, m_records_offset), "records do not fit the file");
+
+        if (l_header.m_roots_offset % FROZEN_ALIGNMENT != 0 ||
+            l_header.m_roots_offset < l_header.m_records_offset + l_header.m_nodes * sizeof(frozen_record) ||
+            l_header.m_roots_offset > l_size ||
+            l_header.m_roots > (l_size - l_header.m_roots_offset) / sizeof(uint32_t))
+            return l_fail(offsetof(frozen_header, m_roots_offset), "roots do not fit the file");
+
+        m_header = &l_header;
+        m_records = reinterpret_cast<const frozen_record*>(static_cast<const char*>(l_map) + l_header.m_records_offset);
+        m_roots = reinterpret_cast<const uint32_t*>(static_cast<const char*>(l_map) + l_header.m_roots_offset);
+
+        return std::nullopt;
+
+    }
+
+    bool frozen_dag::evaluate(
+        size_t a_root,
+        std::span<const uint64_t> a_input
+    ) const
+    {
+        if (!m_header || a_root >= roots())
+            throw std::out_of_range("no such root in the frozen dag");
+
+        if (a_input.size() * 64 < m_header->m_variables)
+            throw std::invalid_argument("input shorter than the variables of the frozen dag");
+
+        uint32_t l_code = m_roots[a_root];
+
+        if (l_code >= m_header->m_nodes + 2)
+            throw std::runtime_error("malformed frozen dag: root out of range");
+
+        while (l_code >= 2)
+        {
+            const frozen_record& l_record = m_records[l_code - 2];
+
+            if (l_record.m_depth >= m_header->m_variables)
+                throw std::runtime_error("malformed frozen dag: depth out of range");
+
+            const uint32_t l_child = (a_input[l_record.m_depth / 64] >> (l_record.m_depth % 64)) & 1 ?
+                l_record.m_positive : l_record.m_negative;
+
+            /// Children precede their parents, so each step
+            ///     moves back and the walk must end.
+            if (l_child >= l_code)
+                throw std::runtime_error("malformed frozen dag: child does not precede its parent");
+
+            l_code = l_child;
+
+        }
+
+        return l_code == 1;
+
+    }
+
+    std::ostream& write_frozen(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots
+    )
+    {
+        /// Gather the nodes, each once.
+        std::vector<const node*> l_nodes;
+
+        {
+            const uint32_t l_epoch = global_node_sink::bound()->next_epoch();
+
+            std::vector<const node*> l_pending(a_roots.begin(), a_roots.end());
+
+            while (!l_pending.empty())
+            {
+                const node* l_node = l_pending.back();
+
+                l_pending.pop_back();
+
+                if (l_node == ZERO || l_node == ONE || !l_node->mark(l_epoch))
+                    continue;
+
+                l_nodes.push_back(l_node);
+
+                l_pending.push_back(l_node->positive());
+                l_pending.push_back(l_node->negative());
+            }
+        }
+
+        if (l_nodes.size() >= UINT32_MAX - 1)
+            throw std::length_error("too many nodes for a frozen dag");
+
+        /// Deeper nodes first, so children precede parents.
+        std::stable_sort(
+            l_nodes.begin(),
+            l_nodes.end(),
+            [](const node* a_x, const node* a_y) { return a_x->depth() > a_y->depth(); }
+        );
+
+        std::unordered_map<const node*, uint32_t> l_codes;
+
+        l_codes.reserve(l_nodes.size());
+
+        for (size_t i = 0; i < l_nodes.size(); i++)
+            l_codes.emplace(l_nodes[i], i + 2);
+
+        const auto l_code = [&](const node* a_node)
+        {
+            return a_node == ZERO ? 0 : a_node == ONE ? 1 : l_codes.at(a_node);
+        };
+
+        frozen_header l_header = {};
+
+        std::memcpy(l_header.m_magic, FROZEN_MAGIC, sizeof(FROZEN_MAGIC));
+
+        l_header.m_version = FROZEN_VERSION;
+        l_header.m_byte_order = FROZEN_BYTE_ORDER;
+        l_header.m_variables = l_nodes.empty() ? 0 : l_nodes.front()->depth() + 1;
+        l_header.m_nodes = l_nodes.size();
+        l_header.m_roots = a_roots.size();
+        l_header.m_records_offset = sizeof(frozen_header);
+        l_header.m_roots_offset = align(l_header.m_records_offset + l_nodes.size() * sizeof(frozen_record));
+
+        std::string l_buffer;
+
+        l_buffer.reserve(FROZEN_BUFFER_BYTES);
+
+        const auto l_flush = [&](size_t a_threshold)
+        {
+            if (l_buffer.size() < a_threshold)
+                return;
+
+            a_ostream.write(l_buffer.data(), l_buffer.size());
+            l_buffer.clear();
+        };
+
+        l_buffer.append(reinterpret_cast<const char*>(&l_header), sizeof(l_header));
+
+        for (const node* l_node : l_nodes)
+        {
+            const frozen_record l_record = { l_node->depth(), l_code(l_node->negative()), l_code(l_node->positive()) };
+
+            l_buffer.append(reinterpret_cast<const char*>(&l_record), sizeof(l_record));
+
+            l_flush(FROZEN_BUFFER_BYTES);
+        }
+
+        l_buffer.append(l_header.m_roots_offset - l_header.m_records_offset - l_nodes.size() * sizeof(frozen_record), '\0');
+
+        for (const node* l_root : a_roots)
+        {
+            const uint32_t l_root_code = l_code(l_root);
+
+            l_buffer.append(reinterpret_cast<const char*>(&l_root_code), sizeof(l_root_code));
+
+            l_flush(FROZEN_BUFFER_BYTES);
+        }
+
+        /// Pad the last section, so that the file is a
+        ///     whole number of aligned blocks.
+        l_buffer.append(align(l_header.m_roots_offset + a_roots.size() * sizeof(uint32_t)) - l_header.m_roots_offset - a_roots.size() * sizeof(uint32_t), '\0');
+
+        l_flush(0);
+
+        return a_ostream;
+
+    }
+
+}
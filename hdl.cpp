@@ -0,0 +1,502 @@
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/hdl.h"
+
+namespace factor
+{
+    /// Text pending for a stream, written a chunk at a time.
+    struct hdl_buffer
+    {
+        std::ostream& m_ostream;
+        std::string m_text;
+
+    };
+
+    static void flush(
+        hdl_buffer& a_buffer,
+        size_t a_threshold
+    )
+    {
+        if (a_buffer.m_text.size() < a_threshold)
+            return;
+
+        a_buffer.m_ostream.write(a_buffer.m_text.data(), a_buffer.m_text.size());
+        a_buffer.m_text.clear();
+    }
+
+    static void append_index(
+        std::string& a_text,
+        uint64_t a_index
+    )
+    {
+        char l_digits[20];
+
+        a_text.append(l_digits, std::to_chars(l_digits, l_digits + sizeof(l_digits), a_index).ptr);
+    }
+
+    /// Appends a_vector[a_index], as in x[3].
+    static void append_bit(
+        std::string& a_text,
+        char a_vector,
+        uint64_t a_index
+    )
+    {
+        a_text += a_vector;
+        a_text += '[';
+        append_index(a_text, a_index);
+        a_text += ']';
+    }
+
+    /// Numbers the nodes beneath the argued roots, children
+    ///     before parents, into a_indices, calling a_visit on
+    ///     each node once it and its children are numbered.
+    template<typename VISIT>
+    static void number_nodes(
+        std::span<const node* const> a_roots,
+        std::unordered_map<const node*, uint64_t>& a_indices,
+        const VISIT& a_visit
+    )
+    {
+        /// Each node is pushed unexpanded, then expanded by
+        ///     pushing its children above it, and numbered
+        ///     when it is reached again.
+        std::vector<std::pair<const node*, bool>> l_pending;
+
+        for (const node* l_root : a_roots)
+        {
+            l_pending.emplace_back(l_root, false);
+
+            while (!l_pending.empty())
+            {
+                auto& [l_node, l_expanded] = l_pending.back();
+
+                if (l_node == ZERO || l_node == ONE || a_indices.contains(l_node))
+                {
+                    l_pending.pop_back();
+                    continue;
+                }
+
+                if (!l_expanded)
+                {
+                    l_expanded = true;
+
+                    const node* l_negative = l_node->negative();
+                    const node* l_positive = l_node->positive();
+
+                    l_pending.emplace_back(l_positive, false);
+                    l_pending.emplace_back(l_negative, false);
+
+                    continue;
+                }
+
+                const node* l_finished = l_node;
+
+                l_pending.pop_back();
+
+                a_indices.emplace(l_finished, a_indices.size());
+
+                a_visit(l_finished);
+
+            }
+        }
+    }
+
+    /// Returns one past the deepest variable
+    ///     beneath the argued roots.
+    static uint32_t count_inputs(
+        std::span<const node* const> a_roots
+    )
+    {
+        const uint32_t l_epoch = global_node_sink::bound()->next_epoch();
+
+        uint32_t l_result = 0;
+
+        std::vector<const node*> l_pending(a_roots.begin(), a_roots.end());
+
+        while (!l_pending.empty())
+        {
+            const node* l_node = l_pending.back();
+
+            l_pending.pop_back();
+
+            if (l_node == ZERO || l_node == ONE || !l_node->mark(l_epoch))
+                continue;
+
+            l_result = std::max(l_result, l_node->depth() + 1);
+
+            l_pending.push_back(l_node->negative());
+            l_pending.push_back(l_node->positive());
+
+        }
+
+        return l_result;
+
+    }
+
+    /// Appends the argued node as a Verilog operand.
+    static void append_operand(
+        std::string& a_text,
+        const node* a_node,
+        const std::unordered_map<const node*, uint64_t>& a_indices
+    )
+    {
+        if (a_node == ZERO || a_node == ONE)
+        {
+            a_text += a_node == ONE ? "1'b1" : "1'b0";
+            return;
+        }
+
+        a_text += 'n';
+        append_index(a_text, a_indices.at(a_node));
+    }
+
+    /// Appends the header of a module over the argued
+    ///     numbers of inputs and outputs.
+    static void append_module(
+        std::string& a_text,
+        std::string_view a_module,
+        uint64_t a_inputs,
+        uint64_t a_outputs
+    )
+    {
+        a_text += "module ";
+        a_text += a_module;
+        a_text += "(x, y);\n  input [";
+        append_index(a_text, std::max<uint64_t>(a_inputs, 1) - 1);
+        a_text += ":0] x;\n  output [";
+        append_index(a_text, std::max<uint64_t>(a_outputs, 1) - 1);
+        a_text += ":0] y;\n";
+    }
+
+    std::ostream& write_verilog(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots,
+        std::string_view a_module
+    )
+    {
+        hdl_buffer l_buffer{ a_ostream };
+
+        l_buffer.m_text.reserve(HDL_BUFFER_BYTES);
+
+        std::string& l_text = l_buffer.m_text;
+
+        append_module(l_text, a_module, count_inputs(a_roots), a_roots.size());
+
+        std::unordered_map<const node*, uint64_t> l_indices;
+
+        number_nodes(
+            a_roots,
+            l_indices,
+            [&](const node* a_node)
+            {
+                l_text += "  wire n";
+                append_index(l_text, l_indices.size() - 1);
+                l_text += " = ";
+                append_bit(l_text, 'x', a_node->depth());
+                l_text += " ? ";
+                append_operand(l_text, a_node->positive(), l_indices);
+                l_text += " : ";
+                append_operand(l_text, a_node->negative(), l_indices);
+                l_text += ";\n";
+
+                flush(l_buffer, HDL_BUFFER_BYTES);
+            }
+        );
+
+        for (size_t i = 0; i < a_roots.size(); i++)
+        {
+            l_text += "  assign ";
+            append_bit(l_text, 'y', i);
+            l_text += " = ";
+            append_operand(l_text, a_roots[i], l_indices);
+            l_text += ";\n";
+        }
+
+        l_text += "endmodule\n";
+
+        flush(l_buffer, 0);
+
+        return a_ostream;
+
+    }
+
+    std::ostream& write_blif(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots,
+        std::string_view a_model
+    )
+    {
+        hdl_buffer l_buffer{ a_ostream };
+
+        l_buffer.m_text.reserve(HDL_BUFFER_BYTES);
+
+        std::string& l_text = l_buffer.m_text;
+
+        l_text += ".model ";
+        l_text += a_model;
+        l_text += "\n.inputs";
+
+        const uint32_t l_inputs = count_inputs(a_roots);
+
+        for (uint32_t i = 0; i < l_inputs; i++)
+        {
+            l_text += ' ';
+            append_bit(l_text, 'x', i);
+            flush(l_buffer, HDL_BUFFER_BYTES);
+        }
+
+        l_text += "\n.outputs";
+
+        for (size_t i = 0; i < a_roots.size(); i++)
+        {
+            l_text += ' ';
+            append_bit(l_text, 'y', i);
+            flush(l_buffer, HDL_BUFFER_BYTES);
+        }
+
+        l_text += '\n';
+
+        std::unordered_map<const node*, uint64_t> l_indices;
+
+        number_nodes(
+            a_roots,
+            l_indices,
+            [&](const node* a_node)
+            {
+                const bool l_negative_node = a_node->negative() != ZERO && a_node->negative() != ONE;
+                const bool l_positive_node = a_node->positive() != ZERO && a_node->positive() != ONE;
+
+                /// The fanins are the variable, then each
+                ///     child that is not constant.
+                l_text += ".names ";
+                append_bit(l_text, 'x', a_node->depth());
+
+                for (const auto& [l_child, l_is_node] : { std::make_pair(a_node->negative(), l_negative_node), std::make_pair(a_node->positive(), l_positive_node) })
+                    if (l_is_node)
+                    {
+                        l_text += " n";
+                        append_index(l_text, l_indices.at(l_child));
+                    }
+
+                l_text += " n";
+                append_index(l_text, l_indices.size() - 1);
+                l_text += '\n';
+
+                /// A row for each case that is not ZERO, requiring
+                ///     that case's child and ignoring the other.
+                if (a_node->negative() != ZERO)
+                {
+                    l_text += '0';
+                    if (l_negative_node)
+                        l_text += '1';
+                    if (l_positive_node)
+                        l_text += '-';
+                    l_text += " 1\n";
+                }
+
+                if (a_node->positive() != ZERO)
+                {
+                    l_text += '1';
+                    if (l_negative_node)
+                        l_text += '-';
+                    if (l_positive_node)
+                        l_text += '1';
+                    l_text += " 1\n";
+                }
+
+                flush(l_buffer, HDL_BUFFER_BYTES);
+            }
+        );
+
+        for (size_t i = 0; i < a_roots.size(); i++)
+        {
+            l_text += ".names ";
+
+            if (a_roots[i] != ZERO && a_roots[i] != ONE)
+            {
+                l_text += 'n';
+                append_index(l_text, l_indices.at(a_roots[i]));
+                l_text += ' ';
+            }
+
+            append_bit(l_text, 'y', i);
+
+            /// A constant output has no fanins, and
+            ///     ONE's single row is empty.
+            if (a_roots[i] == ONE)
+                l_text += "\n1";
+            else if (a_roots[i] != ZERO)
+                l_text += "\n1 1";
+
+            l_text += '\n';
+        }
+
+        l_text += ".end\n";
+
+        flush(l_buffer, 0);
+
+        return a_ostream;
+
+    }
+
+    std::ostream& write_verilog(
+        std::ostream& a_ostream,
+        const pla& a_pla,
+        std::string_view a_module
+    )
+    {
+        hdl_buffer l_buffer{ a_ostream };
+
+        l_buffer.m_text.reserve(HDL_BUFFER_BYTES);
+
+        std::string& l_text = l_buffer.m_text;
+
+        for (const auto& [l_vector, l_labels] : { std::make_pair('x', &a_pla.m_input_labels), std::make_pair('y', &a_pla.m_output_labels) })
+            for (size_t i = 0; i < l_labels->size(); i++)
+            {
+                l_text += "// ";
+                append_bit(l_text, l_vector, i);
+                l_text += ": ";
+                l_text += (*l_labels)[i];
+                l_text += '\n';
+            }
+
+        append_module(l_text, a_module, a_pla.m_inputs, a_pla.m_on.size());
+
+        for (size_t k = 0; k < a_pla.m_on.size(); k++)
+        {
+            l_text += "  assign ";
+            append_bit(l_text, 'y', k);
+            l_text += " =";
+
+            const std::vector<std::string> l_cover = cover_output(a_pla, k);
+
+            if (l_cover.empty())
+                l_text += " 1'b0";
+
+            for (size_t l_cube = 0; l_cube < l_cover.size(); l_cube++)
+            {
+                if (l_cube > 0)
+                    l_text += " |";
+
+                bool l_empty = true;
+
+                for (uint32_t v = 0; v < a_pla.m_inputs; v++)
+                {
+                    if (l_cover[l_cube][v] == '-')
+                        continue;
+
+                    l_text += l_empty ? " " : " & ";
+                    if (l_cover[l_cube][v] == '0')
+                        l_text += '~';
+                    append_bit(l_text, 'x', v);
+
+                    l_empty = false;
+                }
+
+                if (l_empty)
+                    l_text += " 1'b1";
+
+                flush(l_buffer, HDL_BUFFER_BYTES);
+            }
+
+            l_text += ";\n";
+        }
+
+        l_text += "endmodule\n";
+
+        flush(l_buffer, 0);
+
+        return a_ostream;
+
+    }
+
+    std::ostream& write_blif(
+        std::ostream& a_ostream,
+        const pla& a_pla,
+        std::string_view a_model
+    )
+    {
+        hdl_buffer l_buffer{ a_ostream };
+
+        l_buffer.m_text.reserve(HDL_BUFFER_BYTES);
+
+        std::string& l_text = l_buffer.m_text;
+
+        const auto l_append_name = [&](const std::vector<std::string>& a_labels, char a_vector, size_t a_index)
+        {
+            if (a_index < a_labels.size())
+                l_text += a_labels[a_index];
+            else
+                append_bit(l_text, a_vector, a_index);
+        };
+
+        l_text += ".model ";
+        l_text += a_model;
+        l_text += "\n.inputs";
+
+        for (uint32_t i = 0; i < a_pla.m_inputs; i++)
+        {
+            l_text += ' ';
+            l_append_name(a_pla.m_input_labels, 'x', i);
+        }
+
+        l_text += "\n.outputs";
+
+        for (size_t i = 0; i < a_pla.m_on.size(); i++)
+        {
+            l_text += ' ';
+            l_append_name(a_pla.m_output_labels, 'y', i);
+        }
+
+        l_text += '\n';
+
+        std::vector<uint32_t> l_support;
+
+        for (size_t k = 0; k < a_pla.m_on.size(); k++)
+        {
+            const std::vector<std::string> l_cover = cover_output(a_pla, k);
+
+            /// The fanins are the inputs some cube cares about.
+            l_support.clear();
+
+            for (uint32_t v = 0; v < a_pla.m_inputs; v++)
+                if (std::any_of(l_cover.begin(), l_cover.end(), [v](const std::string& a_cube) { return a_cube[v] != '-'; }))
+                    l_support.push_back(v);
+
+            l_text += ".names";
+
+            for (uint32_t v : l_support)
+            {
+                l_text += ' ';
+                l_append_name(a_pla.m_input_labels, 'x', v);
+            }
+
+            l_text += ' ';
+            l_append_name(a_pla.m_output_labels, 'y', k);
+            l_text += '\n';
+
+            for (const std::string& l_cube : l_cover)
+            {
+                for (uint32_t v : l_support)
+                    l_text += l_cube[v];
+
+                l_text += l_support.empty() ? "1\n" : " 1\n";
+
+                flush(l_buffer, HDL_BUFFER_BYTES);
+            }
+        }
+
+        l_text += ".end\n";
+
+        flush(l_buffer, 0);
+
+        return a_ostream;
+
+    }
+
+}
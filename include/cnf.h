@@ -0,0 +1,105 @@
+#ifndef CNF_H
+#define CNF_H
+
+#include <stdint.h>
+#include <chrono>
+#include <istream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "factor.h"
+#include "parser.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// A formula in conjunctive normal form, as read from
+    ///     DIMACS. DIMACS variable v is variable index v - 1.
+    struct cnf
+    {
+        uint32_t m_variables;
+
+        /// Defines each clause as variable indices and signs.
+        std::vector<std::vector<std::pair<uint32_t, bool>>> m_clauses;
+
+    };
+
+    /// The order in which conjoin_clauses conjoins.
+    enum conjunction_schedule : uint8_t
+    {
+        /// Folds the clauses in the order given.
+        FILE_ORDER,
+
+        /// Places each clause in the bucket of its first
+        ///     variable, and conjoins the buckets from the last
+        ///     variable up, each bucket as a balanced tree.
+        BUCKETS,
+    };
+
+    struct conjunction_statistics
+    {
+        /// Defines the node count of the largest
+        ///     intermediate product.
+        size_t m_peak_product_nodes;
+
+        /// Defines the node count of the bound dag afterward,
+        ///     which is its peak, since nodes are never freed.
+        size_t m_dag_nodes;
+
+        size_t m_conjunctions;
+
+        /// Defines the time taken, excluding the time
+        ///     spent counting intermediate products.
+        std::chrono::nanoseconds m_elapsed;
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Defines the most clauses read_dimacs reserves room
+    ///     for ahead of reading them, whatever the count
+    ///     the problem line declares.
+    inline constexpr uint32_t CNF_RESERVED_CLAUSES = uint32_t(1) << 20;
+
+    /// Reads a DIMACS CNF file into a_cnf. Clauses may span
+    ///     lines, the last may omit its terminating 0, and a
+    ///     line beginning with '%' ends the formula.
+    ///
+    ///     Returns the error, its line and its position within
+    ///     the line if the text is malformed, in which case
+    ///     a_cnf is unspecified.
+    std::optional<line_error> read_dimacs(
+        std::istream& a_istream,
+        cnf& a_cnf,
+        size_t a_buffer_bytes = LINE_BUFFER_BYTES
+    );
+
+    /// Constructs the conjunction of the argued clauses into
+    ///     the bound dag, each clause being built directly by
+    ///     clause(). Conjoining in file order lets unrelated parts
+    ///     of the formula multiply each other's size; under BUCKETS,
+    ///     every intermediate product is a function of a suffix of
+    ///     the variable order, so stays closer to the final size.
+    ///     Stops early once the product is ZERO.
+    const node* conjoin_clauses(
+        const cnf& a_cnf,
+        conjunction_statistics& a_statistics,
+        conjunction_schedule a_schedule = BUCKETS
+    );
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include <stdint.h>
+#include <ostream>
+#include <string_view>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Functions whose support is at most this many
+    ///     variables are generated as a lookup table.
+    inline constexpr uint32_t CODEGEN_TABLE_SUPPORT = 6;
+
+    /// Emits a standalone C++ function
+    ///         bool a_name(const uint64_t* x)
+    ///     evaluating the argued function on a bit-packed input,
+    ///     in which variable v is bit v % 64 of x[v / 64], preceded
+    ///     by the #include of <stdint.h> it needs.
+    ///
+    ///     Functions with a support of at most a_table_support
+    ///     variables become a constexpr table indexed by the
+    ///     support (the k-th lowest variable being bit k of the
+    ///     index). A table is one 64-bit word, so a_table_support
+    ///     above six is taken as six. Otherwise each node becomes a conditional
+    ///     expression, and nodes with fan-in greater than one
+    ///     become static helpers named a_name_<k>.
+    std::ostream& generate_cpp(
+        std::ostream& a_ostream,
+        const node* a_root,
+        std::string_view a_name,
+        uint32_t a_table_support = CODEGEN_TABLE_SUPPORT
+    );
+
+    #pragma endregion
+
+}
+
+#endif
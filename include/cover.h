@@ -0,0 +1,197 @@
+#ifndef COVER_H
+#define COVER_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Cubes are written as in a PLA input plane: character v
+    ///     is '0' or '1' if variable v appears complemented or
+    ///     uncomplemented, and '-' if it is absent.
+    ///
+    ///     Cube lists are kept sorted by their suffix from the
+    ///     current depth, ranking '0' < '1' < '-', so that the
+    ///     cubes branching each way on the current variable are
+    ///     contiguous, and a cube that is all dashes sorts last.
+    inline int cube_rank(
+        char a_char
+    )
+    {
+        return a_char == '0' ? 0 : a_char == '1' ? 1 : 2;
+    }
+
+    inline bool cube_suffix_less(
+        std::string_view a_x,
+        std::string_view a_y,
+        uint32_t a_depth
+    )
+    {
+        for (size_t i = a_depth; i < a_x.size(); i++)
+            if (a_x[i] != a_y[i])
+                return cube_rank(a_x[i]) < cube_rank(a_y[i]);
+
+        return false;
+
+    }
+
+    struct cover_construction
+    {
+        /// Sub-lists reached along more than one path, which
+        ///     only arise from cubes absent a variable being
+        ///     merged into both branches of it.
+        std::map<std::pair<uint32_t, std::vector<const char*>>, const node*> m_merged;
+
+    };
+
+    inline const node* from_cubes(
+        cover_construction& a_construction,
+        std::span<const std::string_view> a_cubes,
+        uint32_t a_depth
+    )
+    {
+        if (a_cubes.empty())
+            return ZERO;
+
+        /// The largest cube is all dashes from here on
+        ///     if any is, covering everything.
+        const std::string_view l_last = a_cubes.back();
+
+        if (std::all_of(l_last.begin() + a_depth, l_last.end(), [](char c) { return c == '-'; }))
+            return ONE;
+
+        /// Split the list on the current variable.
+        const auto l_ones = std::find_if(a_cubes.begin(), a_cubes.end(), [a_depth](std::string_view a_cube) { return a_cube[a_depth] != '0'; });
+        const auto l_dashes = std::find_if(l_ones, a_cubes.end(), [a_depth](std::string_view a_cube) { return a_cube[a_depth] == '-'; });
+
+        const std::span<const std::string_view> l_zero_cubes(a_cubes.begin(), l_ones);
+        const std::span<const std::string_view> l_one_cubes(l_ones, l_dashes);
+        const std::span<const std::string_view> l_dash_cubes(l_dashes, a_cubes.end());
+
+        /// Without absent-variable cubes, both branches are
+        ///     already sorted sub-ranges; no copying needed.
+        if (l_dash_cubes.empty())
+            return global_node_sink::bound()->emplace(
+                a_depth,
+                from_cubes(a_construction, l_zero_cubes, a_depth + 1),
+                from_cubes(a_construction, l_one_cubes, a_depth + 1)
+            );
+
+        if (l_zero_cubes.empty() && l_one_cubes.empty())
+            return from_cubes(a_construction, l_dash_cubes, a_depth + 1);
+
+        /// Otherwise, merge the absent-variable cubes into both
+        ///     branches, dropping duplicates as they meet.
+        const auto l_branch = [&](std::span<const std::string_view> a_specified)
+        {
+            if (a_specified.empty())
+                return from_cubes(a_construction, l_dash_cubes, a_depth + 1);
+
+            std::vector<std::string_view> l_merged;
+
+            l_merged.reserve(a_specified.size() + l_dash_cubes.size());
+
+            std::merge(
+                a_specified.begin(),
+                a_specified.end(),
+                l_dash_cubes.begin(),
+                l_dash_cubes.end(),
+                std::back_inserter(l_merged),
+                [a_depth](std::string_view a_x, std::string_view a_y)
+                {
+                    return cube_suffix_less(a_x, a_y, a_depth + 1);
+                }
+            );
+
+            l_merged.erase(
+                std::unique(
+                    l_merged.begin(),
+                    l_merged.end(),
+                    [a_depth](std::string_view a_x, std::string_view a_y)
+                    {
+                        return a_x.substr(a_depth + 1) == a_y.substr(a_depth + 1);
+                    }
+                ),
+                l_merged.end()
+            );
+
+            std::pair<uint32_t, std::vector<const char*>> l_key = { a_depth + 1, {} };
+
+            for (std::string_view l_cube : l_merged)
+                l_key.second.push_back(l_cube.data());
+
+            if (a_construction.m_merged.contains(l_key))
+                return a_construction.m_merged[l_key];
+
+            const node* l_result = from_cubes(a_construction, l_merged, a_depth + 1);
+
+            return a_construction.m_merged[std::move(l_key)] = l_result;
+
+        };
+
+        const node* l_negative = l_branch(l_zero_cubes);
+        const node* l_positive = l_branch(l_one_cubes);
+
+        return global_node_sink::bound()->emplace(a_depth, l_negative, l_positive);
+
+    }
+
+    /// Builds the disjunction of the argued cubes into the bound
+    ///     dag without any apply operation: the cubes are sorted
+    ///     once, then partitioned on each variable in turn, every
+    ///     node being emplaced directly. All cubes must have
+    ///     the same length.
+    inline const node* from_cubes(
+        std::vector<std::string_view> a_cubes
+    )
+    {
+        if (a_cubes.empty())
+            return ZERO;
+
+        const size_t l_variables = a_cubes.front().size();
+
+        for (std::string_view l_cube : a_cubes)
+        {
+            if (l_cube.size() != l_variables)
+                throw std::invalid_argument("cubes differ in length");
+
+            if (l_cube.find_first_not_of("01-") != std::string_view::npos)
+                throw std::invalid_argument("cube has a character other than '0', '1' or '-'");
+        }
+
+        std::sort(
+            a_cubes.begin(),
+            a_cubes.end(),
+            [](std::string_view a_x, std::string_view a_y)
+            {
+                return cube_suffix_less(a_x, a_y, 0);
+            }
+        );
+
+        a_cubes.erase(std::unique(a_cubes.begin(), a_cubes.end()), a_cubes.end());
+
+        cover_construction l_construction;
+
+        return from_cubes(l_construction, a_cubes, 0);
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
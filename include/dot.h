@@ -0,0 +1,43 @@
+#ifndef DOT_H
+#define DOT_H
+
+#include <stdint.h>
+#include <ostream>
+#include <span>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Writes the dag beneath the argued roots as a Graphviz
+    ///     digraph. Each reachable node is visited once, by the
+    ///     epoch marks of the bound dag, to which the nodes must
+    ///     belong, and is written as soon as it is visited, so
+    ///     nothing but the traversal stack is held in memory.
+    ///
+    ///     Nodes are labelled by variable, by name where the bound
+    ///     dag's symbol table has one, and each is placed in the
+    ///     rank=same subgraph of its depth. Negative edges are
+    ///     dashed and positive edges solid, and root i is pointed
+    ///     to by a node labelled i.
+    ///
+    ///     Only nodes within a_levels variables of the topmost
+    ///     root are written; edges to deeper nodes lead to a
+    ///     single node labelled "...".
+    std::ostream& write_dot(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots,
+        uint32_t a_levels = UINT32_MAX
+    );
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,488 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include <stdint.h>
+#include <assert.h>
+#include <bit>
+#include <array>
+#include <span>
+#include <vector>
+#include <map>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// Evaluates a function on many assignments per traversal.
+    ///     Inputs are transposed: word v holds the value of
+    ///     variable v in each of 64 assignments, one per bit.
+    class batch_evaluator
+    {
+        /// A reachable node, by the slots of its children.
+        struct step
+        {
+            uint32_t m_depth;
+            uint32_t m_negative;
+            uint32_t m_positive;
+        };
+
+        /// Slots 0 and 1 hold the ZERO and ONE terminals.
+        static constexpr uint32_t ZERO_SLOT = 0;
+        static constexpr uint32_t ONE_SLOT = 1;
+        static constexpr uint32_t FIRST_SLOT = 2;
+
+        /// The reachable nodes, children before parents,
+        ///     so that the last step computes the root.
+        std::vector<step> m_steps;
+
+        /// The slot holding the result.
+        uint32_t m_root;
+
+        /// The number of variables the inputs must cover.
+        uint32_t m_variables;
+
+        /// Scratch space for the per-slot results.
+        std::vector<uint64_t> m_values;
+
+        uint32_t schedule(
+            std::map<const node*, uint32_t>& a_slots,
+            const node* a_node
+        )
+        {
+            if (a_node == ZERO)
+                return ZERO_SLOT;
+            if (a_node == ONE)
+                return ONE_SLOT;
+
+            if (a_slots.contains(a_node))
+                return a_slots[a_node];
+
+            /// Schedule both children before the node itself.
+            const uint32_t l_negative = schedule(a_slots, a_node->negative());
+            const uint32_t l_positive = schedule(a_slots, a_node->positive());
+
+            m_steps.push_back({ a_node->depth(), l_negative, l_positive });
+            m_variables = std::max(m_variables, a_node->depth() + 1);
+
+            return a_slots[a_node] = FIRST_SLOT + m_steps.size() - 1;
+
+        }
+
+    public:
+
+        batch_evaluator(
+            const node* a_root
+        ) :
+            m_variables(0)
+        {
+            /// The topological order is computed once here,
+            ///     and replayed by every evaluation.
+            std::map<const node*, uint32_t> l_slots;
+            m_root = schedule(l_slots, a_root);
+        }
+
+        /// The number of distinct nodes evaluated per batch.
+        size_t size(
+
+        ) const
+        {
+            return m_steps.size();
+        }
+
+        /// The number of input words an evaluation reads.
+        uint32_t variables(
+
+        ) const
+        {
+            return m_variables;
+        }
+
+        /// Evaluates 64 * LANES assignments at once. Each input
+        ///     element holds one variable across LANES words; the
+        ///     lane loop is fixed-width so that e.g. LANES = 4
+        ///     compiles to 256-bit operations under -mavx2.
+        template<size_t LANES>
+        std::array<uint64_t, LANES> evaluate(
+            std::span<const std::array<uint64_t, LANES>> a_inputs
+        )
+        {
+            assert(a_inputs.size() >= m_variables);
+
+            return run<LANES>(
+                [a_inputs](uint32_t a_variable)
+                {
+                    return a_inputs[a_variable].data();
+                }
+            );
+
+        }
+
+        /// Evaluates 64 assignments, one per bit of the words.
+        uint64_t evaluate(
+            std::span<const uint64_t> a_inputs
+        )
+        {
+            assert(a_inputs.size() >= m_variables);
+
+            return run<1>(
+                [a_inputs](uint32_t a_variable)
+                {
+                    return &a_inputs[a_variable];
+                }
+            )[0];
+
+        }
+
+    private:
+
+        /// Replays the schedule, reading the LANES words
+        ///     of variable v from a_input(v).
+        template<size_t LANES, typename INPUT>
+        std::array<uint64_t, LANES> run(
+            const INPUT& a_input
+        )
+        {
+            m_values.resize((FIRST_SLOT + m_steps.size()) * LANES);
+
+            uint64_t* l_values = m_values.data();
+
+            for (size_t l = 0; l < LANES; l++)
+            {
+                l_values[ZERO_SLOT * LANES + l] = 0;
+                l_values[ONE_SLOT * LANES + l] = ~0ULL;
+            }
+
+            uint64_t* l_result = l_values + FIRST_SLOT * LANES;
+
+            for (const step& l_step : m_steps)
+            {
+                const uint64_t* l_input = a_input(l_step.m_depth);
+                const uint64_t* l_negative = l_values + l_step.m_negative * LANES;
+                const uint64_t* l_positive = l_values + l_step.m_positive * LANES;
+
+                /// Select per bit between the children's results.
+                for (size_t l = 0; l < LANES; l++)
+                    l_result[l] = (l_input[l] & l_positive[l]) | (~l_input[l] & l_negative[l]);
+
+                l_result += LANES;
+
+            }
+
+            std::array<uint64_t, LANES> l_output;
+
+            for (size_t l = 0; l < LANES; l++)
+                l_output[l] = l_values[m_root * LANES + l];
+
+            return l_output;
+
+        }
+
+    };
+
+    /// A function laid out as a flat array of branch records,
+    ///     for evaluation without chasing node pointers.
+    class compiled_function
+    {
+    public:
+
+        /// Child indices at or above this value are terminals.
+        static constexpr uint32_t ZERO_INDEX = 0xFFFFFFFE;
+        static constexpr uint32_t ONE_INDEX = 0xFFFFFFFF;
+
+        /// A node, by its variable and the record indices
+        ///     of its children (negative first), so that an
+        ///     input bit selects the next index directly.
+        ///     Records are padded to 16 bytes so indexing
+        ///     them is a shift rather than a multiply.
+        struct record
+        {
+            uint32_t m_variable;
+            uint32_t m_children[2];
+            uint32_t m_reserved;
+        };
+
+    private:
+
+        /// The records in depth-first preorder, so the root is
+        ///     record 0 and each negative child, where not shared,
+        ///     immediately follows its parent.
+        std::vector<record> m_records;
+
+        /// The index evaluation starts at; a terminal index
+        ///     if the function is constant.
+        uint32_t m_root;
+
+        uint32_t compile(
+            std::map<const node*, uint32_t>& a_indices,
+            const node* a_node
+        )
+        {
+            if (a_node == ZERO)
+                return ZERO_INDEX;
+            if (a_node == ONE)
+                return ONE_INDEX;
+
+            if (a_indices.contains(a_node))
+                return a_indices[a_node];
+
+            const uint32_t l_index = m_records.size();
+
+            a_indices[a_node] = l_index;
+
+            m_records.push_back({ a_node->depth(), { 0, 0 }, 0 });
+
+            /// Compile the children after reserving the parent,
+            ///     taking care not to hold a reference into the
+            ///     vector across the recursive growth.
+            const uint32_t l_negative = compile(a_indices, a_node->negative());
+            const uint32_t l_positive = compile(a_indices, a_node->positive());
+
+            m_records[l_index].m_children[0] = l_negative;
+            m_records[l_index].m_children[1] = l_positive;
+
+            return l_index;
+
+        }
+
+    public:
+
+        compiled_function(
+            const node* a_root
+        )
+        {
+            std::map<const node*, uint32_t> l_indices;
+            m_root = compile(l_indices, a_root);
+        }
+
+        const std::vector<record>& records(
+
+        ) const
+        {
+            return m_records;
+        }
+
+        uint32_t root(
+
+        ) const
+        {
+            return m_root;
+        }
+
+        /// Evaluates the function on a bit-packed input,
+        ///     in which variable v is bit v % 64 of word v / 64.
+        bool evaluate(
+            std::span<const uint64_t> a_input
+        ) const
+        {
+            const record* l_records = m_records.data();
+
+            uint32_t l_index = m_root;
+
+            while (l_index < ZERO_INDEX)
+            {
+                const record& l_record = l_records[l_index];
+
+                assert(l_record.m_variable / 64 < a_input.size());
+
+                const uint64_t l_bit =
+                    (a_input[l_record.m_variable / 64] >> (l_record.m_variable % 64)) & 1;
+
+                l_index = l_record.m_children[l_bit];
+
+            }
+
+            return l_index == ONE_INDEX;
+
+        }
+
+    };
+
+    /// Evaluates a function on a sequence of inputs, reusing
+    ///     the root-to-terminal path of the previous input. Only
+    ///     the part of the path below the shallowest changed
+    ///     variable is walked again.
+    class incremental_evaluator
+    {
+        /// Marks a variable not tested along the path.
+        static constexpr uint32_t NOT_ON_PATH = 0xFFFFFFFF;
+
+        const node* m_root;
+
+        /// The current input, bit-packed.
+        std::vector<uint64_t> m_input;
+
+        /// The non-terminal nodes from the root
+        ///     to the current result.
+        std::vector<const node*> m_path;
+
+        /// The index in m_path of the node testing
+        ///     each variable, if any.
+        std::vector<uint32_t> m_positions;
+
+        bool m_result;
+
+        /// The number of nodes visited so far.
+        size_t m_steps;
+
+        const node* step(
+            const node* a_node
+        ) const
+        {
+            const uint32_t l_depth = a_node->depth();
+
+            if ((m_input[l_depth / 64] >> (l_depth % 64)) & 1)
+                return a_node->positive();
+            else
+                return a_node->negative();
+        }
+
+        /// Discards the path from the argued index on, and
+        ///     walks it again under the current input.
+        void resume(
+            size_t a_index
+        )
+        {
+            for (size_t i = a_index; i < m_path.size(); i++)
+                m_positions[m_path[i]->depth()] = NOT_ON_PATH;
+
+            m_path.resize(a_index);
+
+            const node* l_node = m_path.empty() ? m_root : step(m_path.back());
+
+            while (l_node != ZERO && l_node != ONE)
+            {
+                assert(l_node->depth() < m_positions.size());
+
+                m_positions[l_node->depth()] = m_path.size();
+                m_path.push_back(l_node);
+                m_steps++;
+
+                l_node = step(l_node);
+
+            }
+
+            m_result = l_node == ONE;
+
+        }
+
+    public:
+
+        incremental_evaluator(
+            const node* a_root,
+            std::span<const uint64_t> a_input
+        ) :
+            m_root(a_root),
+            m_input(a_input.begin(), a_input.end()),
+            m_positions(a_input.size() * 64, NOT_ON_PATH),
+            m_steps(0)
+        {
+            resume(0);
+        }
+
+        /// The value of the function on the current input.
+        bool result(
+
+        ) const
+        {
+            return m_result;
+        }
+
+        const std::vector<uint64_t>& input(
+
+        ) const
+        {
+            return m_input;
+        }
+
+        size_t steps(
+
+        ) const
+        {
+            return m_steps;
+        }
+
+        /// Toggles one input variable. If the variable is not
+        ///     tested along the current path, the result
+        ///     cannot change and no work is done.
+        bool flip(
+            uint32_t a_variable_index
+        )
+        {
+            assert(a_variable_index < m_positions.size());
+
+            m_input[a_variable_index / 64] ^= 1ULL << (a_variable_index % 64);
+
+            if (m_positions[a_variable_index] != NOT_ON_PATH)
+                resume(m_positions[a_variable_index]);
+
+            return m_result;
+
+        }
+
+        /// Moves to an arbitrary input, resuming from the
+        ///     shallowest path node whose variable changed.
+        bool evaluate(
+            std::span<const uint64_t> a_input
+        )
+        {
+            assert(a_input.size() == m_input.size());
+
+            size_t l_resume = m_path.size();
+
+            for (size_t w = 0; w < m_input.size(); w++)
+            {
+                for (uint64_t l_changed = m_input[w] ^ a_input[w]; l_changed != 0; l_changed &= l_changed - 1)
+                {
+                    const uint32_t l_position =
+                        m_positions[w * 64 + std::countr_zero(l_changed)];
+
+                    if (l_position != NOT_ON_PATH)
+                        l_resume = std::min<size_t>(l_resume, l_position);
+                }
+
+                m_input[w] = a_input[w];
+
+            }
+
+            if (l_resume < m_path.size())
+                resume(l_resume);
+
+            return m_result;
+
+        }
+
+        /// Visits all 2^n assignments of variables [0, n) in Gray
+        ///     code order, calling a_visit(input, result) for each.
+        ///     The deepest variable flips most often, so the
+        ///     sweep costs amortized O(1) steps per assignment.
+        template<typename VISIT>
+        void sweep(
+            uint32_t a_variables,
+            const VISIT& a_visit
+        )
+        {
+            assert(a_variables < 64);
+
+            a_visit(std::span<const uint64_t>(m_input), m_result);
+
+            for (uint64_t i = 1; i < (1ULL << a_variables); i++)
+            {
+                flip(a_variables - 1 - std::countr_zero(i));
+                a_visit(std::span<const uint64_t>(m_input), m_result);
+            }
+
+        }
+
+    };
+
+    #pragma endregion
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define FACTOR_H
 
 #include <stdint.h>
+#include <assert.h>
 #include <utility>
 #include <vector>
 #include <map>
@@ -11,6 +12,15 @@
 #include <istream>
 #include <functional>
 #include <stack>
+#include <span>
+#include <bitset>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 
 #include "../digital-logic/include/logic.h"
 
@@ -33,6 +43,11 @@ namespace factor
         /// Defines the depth of the factor in the tree.
         uint32_t m_depth;
 
+        /// Defines the epoch of the traversal that last visited
+        ///     the node, which fits in the padding before the
+        ///     children. See dag::next_epoch.
+        mutable uint32_t m_mark;
+
         /// Defines the subtrees.
         const node* m_negative;
         const node* m_positive;
@@ -45,6 +60,7 @@ namespace factor
             const node* a_right_child
         ) :
             m_depth(a_depth),
+            m_mark(0),
             m_negative(a_left_child),
             m_positive(a_right_child)
         {
@@ -72,6 +88,21 @@ namespace factor
             return m_positive;
         }
 
+        /// Marks the node visited in the argued epoch, and
+        ///     returns whether it was not already.
+        bool mark(
+            uint32_t a_epoch
+        ) const
+        {
+            if (m_mark == a_epoch)
+                return false;
+
+            m_mark = a_epoch;
+
+            return true;
+
+        }
+
         bool operator<(
             const node& a_other
         ) const
@@ -91,11 +122,210 @@ namespace factor
 
     };
 
+    /// Maps variable names to indices and back. Lookups take a
+    ///     string_view and allocate nothing, and the table may be
+    ///     read and extended from several threads at once.
+    class symbol_table
+    {
+        struct name_hash
+        {
+            using is_transparent = void;
+
+            size_t operator()(
+                std::string_view a_name
+            ) const
+            {
+                return std::hash<std::string_view>()(a_name);
+            }
+
+        };
+
+        std::unordered_map<std::string, uint32_t, name_hash, std::equal_to<>> m_indices;
+
+        /// Defines the name of each index, empty if it has none.
+        ///     These view the keys of m_indices, whose storage
+        ///     never moves.
+        std::vector<std::string_view> m_names;
+
+        /// Defines the lowest index a new name may receive.
+        uint32_t m_next = 0;
+
+        mutable std::shared_mutex m_mutex;
+
+        void bind(
+            std::string_view a_name,
+            uint32_t a_variable_index
+        )
+        {
+            if (const auto l_entry = m_indices.find(a_name); l_entry != m_indices.end())
+            {
+                if (l_entry->second != a_variable_index)
+                    throw std::invalid_argument("variable name already has another index");
+                return;
+            }
+
+            if (a_variable_index < m_names.size() && !m_names[a_variable_index].empty())
+                throw std::invalid_argument("variable index already has another name");
+
+            if (a_variable_index >= m_names.size())
+                m_names.resize(a_variable_index + 1);
+
+            m_names[a_variable_index] = m_indices.emplace(a_name, a_variable_index).first->first;
+
+        }
+
+    public:
+        /// Returns the index of the argued name, giving it
+        ///     the lowest unnamed index not in a_taken if it is new.
+        ///     a_taken is ascending and lists the indices written
+        ///     as "[i]" in the expression being read, so that a new
+        ///     name never takes a variable the expression already
+        ///     uses by number. Indices used by number only in other
+        ///     expressions are unknown here; assign keeps them apart.
+        uint32_t intern(
+            std::string_view a_name,
+            std::span<const uint32_t> a_taken = {}
+        )
+        {
+            {
+                std::shared_lock l_lock(m_mutex);
+
+                if (const auto l_entry = m_indices.find(a_name); l_entry != m_indices.end())
+                    return l_entry->second;
+            }
+
+            std::unique_lock l_lock(m_mutex);
+
+            /// Another thread may have added it meanwhile.
+            if (const auto l_entry = m_indices.find(a_name); l_entry != m_indices.end())
+                return l_entry->second;
+
+            while (m_next < m_names.size() && !m_names[m_next].empty())
+                m_next++;
+
+            uint32_t l_index = m_next;
+
+            while ((l_index < m_names.size() && !m_names[l_index].empty()) ||
+                   std::binary_search(a_taken.begin(), a_taken.end(), l_index))
+                l_index++;
+
+            bind(a_name, l_index);
+
+            return l_index;
+
+        }
+
+        /// Preassigns the argued name the argued index. Throws
+        ///     std::invalid_argument if either is already bound
+        ///     to something else.
+        void assign(
+            std::string_view a_name,
+            uint32_t a_variable_index
+        )
+        {
+            std::unique_lock l_lock(m_mutex);
+
+            bind(a_name, a_variable_index);
+
+        }
+
+        /// Preassigns an order: name i receives index a_first + i.
+        void assign(
+            std::span<const std::string_view> a_names,
+            uint32_t a_first = 0
+        )
+        {
+            std::unique_lock l_lock(m_mutex);
+
+            m_indices.reserve(m_indices.size() + a_names.size());
+
+            for (size_t i = 0; i < a_names.size(); i++)
+                bind(a_names[i], a_first + i);
+
+        }
+
+        std::optional<uint32_t> find(
+            std::string_view a_name
+        ) const
+        {
+            std::shared_lock l_lock(m_mutex);
+
+            if (const auto l_entry = m_indices.find(a_name); l_entry != m_indices.end())
+                return l_entry->second;
+
+            return std::nullopt;
+
+        }
+
+        /// Returns the name of the argued index,
+        ///     or an empty view if it has none.
+        std::string_view name(
+            uint32_t a_variable_index
+        ) const
+        {
+            std::shared_lock l_lock(m_mutex);
+
+            return a_variable_index < m_names.size() ? m_names[a_variable_index] : std::string_view();
+
+        }
+
+        /// Returns one past the largest index with a name.
+        uint32_t extent(
+
+        ) const
+        {
+            std::shared_lock l_lock(m_mutex);
+
+            return m_names.size();
+
+        }
+
+        size_t size(
+
+        ) const
+        {
+            std::shared_lock l_lock(m_mutex);
+
+            return m_indices.size();
+
+        }
+
+    };
+
     std::ostream& operator<<(
         std::ostream& a_ostream,
         const node* a_node
     );
 
+    /// Prints as operator<< does, but writes each variable
+    ///     that has a name in a_symbols by that name.
+    std::ostream& print(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table& a_symbols
+    );
+
+    /// Prints the argued function in shared form, linear in
+    ///     the size of its dag where operator<< may be exponential.
+    ///     Each node with more than one parent is written once, as
+    ///     a numbered definition on a line of its own, "$k = ...",
+    ///     in the notation of operator<<, and is referred to as
+    ///     "$k" thereafter. Definitions precede their uses, and the
+    ///     last line is the function itself. A constant is written
+    ///     as "()" or "()'". read_shared reads the form back.
+    std::ostream& print_shared(
+        std::ostream& a_ostream,
+        const node* a_node
+    );
+
+    /// Prints as print_shared does, but writes each variable
+    ///     that has a name in a_symbols by that name.
+    std::ostream& print_shared(
+        std::ostream& a_ostream,
+        const node* a_node,
+        const symbol_table& a_symbols
+    );
+
     std::istream& operator>>(
         std::istream& a_istream,
         const node*& a_node
@@ -109,7 +339,8 @@ namespace factor
     {
         dag(
             
-        )
+        ) :
+            m_epoch(0)
         {
 
         }
@@ -134,6 +365,21 @@ namespace factor
             return m_nodes.size();
         }
 
+        /// Defines the names of the variables of this dag.
+        symbol_table& symbols(
+
+        )
+        {
+            return m_symbols;
+        }
+
+        const symbol_table& symbols(
+
+        ) const
+        {
+            return m_symbols;
+        }
+
         const node* emplace(
             uint32_t a_depth,
             const node* a_negative_child,
@@ -146,17 +392,59 @@ namespace factor
                 ///     avoid emplacing anything.
                 return a_negative_child;
 
-            return &*m_nodes.emplace(
-                a_depth,
-                a_negative_child,
-                a_positive_child
-            ).first;
+            const node l_node(a_depth, a_negative_child, a_positive_child);
+
+            /// Look the node up before emplacing, since
+            ///     emplace allocates even when it is found.
+            const auto l_position = m_nodes.lower_bound(l_node);
+
+            if (l_position != m_nodes.end() && !(l_node < *l_position))
+                return &*l_position;
+
+            return &*m_nodes.emplace_hint(l_position, l_node);
             
         }
+
+        /// Calls a_function on each node, deepest first, so
+        ///     that children come before their parents.
+        template<typename FUNCTION>
+        void for_each_node(
+            const FUNCTION& a_function
+        ) const
+        {
+            for (auto l_node = m_nodes.rbegin(); l_node != m_nodes.rend(); l_node++)
+                a_function(&*l_node);
+        }
+
+        /// Begins a traversal that marks the nodes it visits,
+        ///     returning an epoch no node is yet marked with, so
+        ///     that no marks need clearing. Only one such traversal
+        ///     of a dag may be under way at a time.
+        uint32_t next_epoch(
+
+        )
+        {
+            /// Once the epochs wrap around, old marks
+            ///     could match, so all are cleared.
+            if (++m_epoch == 0)
+            {
+                for (const node& l_node : m_nodes)
+                    l_node.mark(0);
+
+                m_epoch = 1;
+            }
+
+            return m_epoch;
+
+        }
         
     private:
         std::set<node> m_nodes;
 
+        uint32_t m_epoch;
+
+        symbol_table m_symbols;
+
     };
 
     #pragma endregion
@@ -166,9 +454,11 @@ namespace factor
     ////////////////////////////////////////////
     #pragma region GLOBAL VARS
 
+    /// Each thread binds its own dag, so that threads
+    ///     may build into private dags concurrently.
     class global_node_sink
     {
-        static dag* s_graph;
+        static thread_local dag* s_graph;
 
     public:
         static void bind(
@@ -207,6 +497,97 @@ namespace factor
             );
     }
 
+    /// Constructs the product of the argued literals, each
+    ///     given as a variable index and sign, by emplacing
+    ///     the chain directly from the deepest variable up.
+    ///     A contradictory product is ZERO, and the empty
+    ///     product is ONE.
+    ///
+    ///     The chain may instead be emplaced atop a_tail, which
+    ///     must lie strictly below every literal's variable,
+    ///     yielding the product's conjunction with a_tail.
+    inline const node* cube(
+        std::span<const std::pair<uint32_t, bool>> a_literals,
+        const node* a_tail = ONE
+    )
+    {
+        std::vector<std::pair<uint32_t, bool>> l_literals(a_literals.begin(), a_literals.end());
+
+        std::sort(l_literals.begin(), l_literals.end());
+
+        /// Sorting places both signs of a variable side by
+        ///     side, so contradictions are found before
+        ///     anything is emplaced.
+        for (size_t i = 1; i < l_literals.size(); i++)
+            if (l_literals[i].first == l_literals[i - 1].first &&
+                l_literals[i].second != l_literals[i - 1].second)
+                return ZERO;
+
+        if (a_tail == ZERO)
+            return ZERO;
+
+        assert(a_tail == ONE || l_literals.empty() || l_literals.back().first < a_tail->depth());
+
+        const node* l_result = a_tail;
+
+        for (size_t i = l_literals.size(); i-- > 0;)
+        {
+            /// Repeated literals are absorbed.
+            if (i + 1 < l_literals.size() && l_literals[i] == l_literals[i + 1])
+                continue;
+
+            const auto [l_variable_index, l_sign] = l_literals[i];
+
+            l_result = global_node_sink::bound()->emplace(
+                l_variable_index,
+                l_sign ? ZERO : l_result,
+                l_sign ? l_result : ZERO
+            );
+        }
+
+        return l_result;
+
+    }
+
+    /// Constructs the sum of the argued literals, the dual of
+    ///     cube: each literal's variable takes its sign to ONE
+    ///     and otherwise falls through to the rest of the sum.
+    ///     A sum containing both signs of a variable is ONE,
+    ///     and the empty sum is ZERO.
+    inline const node* clause(
+        std::span<const std::pair<uint32_t, bool>> a_literals
+    )
+    {
+        std::vector<std::pair<uint32_t, bool>> l_literals(a_literals.begin(), a_literals.end());
+
+        std::sort(l_literals.begin(), l_literals.end());
+
+        for (size_t i = 1; i < l_literals.size(); i++)
+            if (l_literals[i].first == l_literals[i - 1].first &&
+                l_literals[i].second != l_literals[i - 1].second)
+                return ONE;
+
+        const node* l_result = ZERO;
+
+        for (size_t i = l_literals.size(); i-- > 0;)
+        {
+            /// Repeated literals are absorbed.
+            if (i + 1 < l_literals.size() && l_literals[i] == l_literals[i + 1])
+                continue;
+
+            const auto [l_variable_index, l_sign] = l_literals[i];
+
+            l_result = global_node_sink::bound()->emplace(
+                l_variable_index,
+                l_sign ? l_result : ONE,
+                l_sign ? ONE : l_result
+            );
+        }
+
+        return l_result;
+
+    }
+
     inline const node* join(
         std::map<std::set<const node*>, const node*>& a_cache,
         const node* a_ident,
@@ -290,6 +671,28 @@ namespace factor
 
     }
 
+    /// Copies the function rooted at a_node, which may
+    ///     live in another dag, into the bound dag.
+    inline const node* transplant(
+        std::map<const node*, const node*>& a_cache,
+        const node* a_node
+    )
+    {
+        if (a_node == ZERO || a_node == ONE)
+            return a_node;
+
+        return CACHE(
+            a_cache,
+            a_node,
+            global_node_sink::bound()->emplace(
+                a_node->depth(),
+                transplant(a_cache, a_node->negative()),
+                transplant(a_cache, a_node->positive())
+            )
+        );
+
+    }
+
     /// Evaluates the function represented by the
     ///     factor DAG on the argued input.
     inline bool evaluate(
@@ -303,6 +706,8 @@ namespace factor
         if (a_node == ONE)
             return true;
 
+        assert(a_node->depth() < a_input.size());
+
         if (a_input[a_node->depth()])
             return evaluate(a_node->positive(), a_input);
         else
@@ -310,6 +715,53 @@ namespace factor
             
     }
 
+    /// Evaluates the function on a bit-packed input, in
+    ///     which variable v is bit v % 64 of word v / 64.
+    inline bool evaluate(
+        const node* a_node,
+        std::span<const uint64_t> a_input
+    )
+    {
+        while (a_node != ZERO && a_node != ONE)
+        {
+            const uint32_t l_depth = a_node->depth();
+
+            assert(l_depth / 64 < a_input.size());
+
+            if ((a_input[l_depth / 64] >> (l_depth % 64)) & 1)
+                a_node = a_node->positive();
+            else
+                a_node = a_node->negative();
+
+        }
+
+        return a_node == ONE;
+        
+    }
+
+    /// Evaluates the function on a fixed-width input,
+    ///     in which variable v is bit v.
+    template<size_t N>
+    inline bool evaluate(
+        const node* a_node,
+        const std::bitset<N>& a_input
+    )
+    {
+        while (a_node != ZERO && a_node != ONE)
+        {
+            assert(a_node->depth() < N);
+
+            if (a_input[a_node->depth()])
+                a_node = a_node->positive();
+            else
+                a_node = a_node->negative();
+
+        }
+
+        return a_node == ONE;
+        
+    }
+
     #pragma endregion
 
 }
@@ -0,0 +1,177 @@
+#ifndef FROZEN_H
+#define FROZEN_H
+
+#include <stdint.h>
+#include <optional>
+#include <ostream>
+#include <span>
+
+#include "factor.h"
+#include "parser.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// Defines the alignment of each section of a frozen dag.
+    inline constexpr size_t FROZEN_ALIGNMENT = 64;
+
+    /// The first section of a frozen dag file. Integers are
+    ///     in the byte order of the machine that wrote it.
+    struct frozen_header
+    {
+        /// Defines "FDAGFRZN".
+        char m_magic[8];
+
+        uint32_t m_version;
+
+        /// Defines 0x01020304, as written.
+        uint32_t m_byte_order;
+
+        /// Defines one past the deepest variable.
+        uint32_t m_variables;
+
+        uint32_t m_reserved;
+
+        uint64_t m_nodes;
+        uint64_t m_roots;
+
+        /// Defines the offsets of the sections of
+        ///     node records and of roots.
+        uint64_t m_records_offset;
+        uint64_t m_roots_offset;
+
+        uint64_t m_padding;
+
+    };
+
+    static_assert(sizeof(frozen_header) == FROZEN_ALIGNMENT);
+
+    /// A node of a frozen dag. A node is referred to as
+    ///     0 for ZERO, 1 for ONE, and otherwise as 2 more
+    ///     than the index of its record. Every child's
+    ///     record precedes its parents'.
+    struct frozen_record
+    {
+        uint32_t m_depth;
+        uint32_t m_negative;
+        uint32_t m_positive;
+
+    };
+
+    /// A read-only dag mapped from a file written by write_frozen
+    ///     and evaluated where it lies, with no deserialization.
+    ///     Opening checks only the header, so takes constant time,
+    ///     and the mapping is shared, so every process mapping the
+    ///     file reads the one copy in the page cache.
+    class frozen_dag
+    {
+        void* m_map;
+        size_t m_map_size;
+
+        const frozen_header* m_header;
+        const frozen_record* m_records;
+        const uint32_t* m_roots;
+
+        void close(
+
+        );
+
+    public:
+        frozen_dag(
+
+        ) :
+            m_map(nullptr),
+            m_map_size(0),
+            m_header(nullptr),
+            m_records(nullptr),
+            m_roots(nullptr)
+        {
+
+        }
+
+        frozen_dag(
+            const frozen_dag&
+        ) = delete;
+
+        frozen_dag& operator=(
+            const frozen_dag&
+        ) = delete;
+
+        ~frozen_dag(
+
+        )
+        {
+            close();
+        }
+
+        /// Maps the frozen dag at a_path, replacing any mapped
+        ///     before. Returns the error and its offset in the file
+        ///     if the header is malformed or does not fit the file.
+        ///     Throws std::system_error if the file cannot be opened
+        ///     or mapped.
+        std::optional<parse_error> open(
+            const char* a_path
+        );
+
+        size_t size(
+
+        ) const
+        {
+            return m_header ? m_header->m_nodes : 0;
+        }
+
+        size_t roots(
+
+        ) const
+        {
+            return m_header ? m_header->m_roots : 0;
+        }
+
+        uint32_t variables(
+
+        ) const
+        {
+            return m_header ? m_header->m_variables : 0;
+        }
+
+        /// Evaluates root a_root on a bit-packed input, in
+        ///     which variable v is bit v % 64 of word v / 64.
+        ///     Throws std::out_of_range if there is no such
+        ///     root, as when nothing is open, std::invalid_argument
+        ///     if the input is shorter than variables(), and
+        ///     std::runtime_error on reaching a malformed record.
+        bool evaluate(
+            size_t a_root,
+            std::span<const uint64_t> a_input
+        ) const;
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Writes the nodes beneath the argued roots as a frozen
+    ///     dag: a frozen_header, the node records from the deepest
+    ///     level up, and the root table, each section padded to
+    ///     FROZEN_ALIGNMENT bytes. The text is written in chunks.
+    ///     Throws std::length_error if there are 2^32 - 2 nodes
+    ///     or more.
+    std::ostream& write_frozen(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots
+    );
+
+    #pragma endregion
+
+}
+
+#endif
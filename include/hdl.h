@@ -0,0 +1,73 @@
+#ifndef HDL_H
+#define HDL_H
+
+#include <stdint.h>
+#include <ostream>
+#include <span>
+#include <string_view>
+
+#include "factor.h"
+#include "pla.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Defines the size of the chunks in which
+    ///     netlists are written.
+    inline constexpr size_t HDL_BUFFER_BYTES = size_t(1) << 20;
+
+    /// Writes the argued functions as a structural Verilog module
+    ///     with input vector x, variable i being x[i] up to the
+    ///     deepest variable used, and output vector y, root i being
+    ///     y[i]. Each node becomes one multiplexer, a wire n<k>
+    ///     selecting between its cases by its variable, written once
+    ///     however many parents share it, after its children.
+    ///
+    ///     Nodes are numbered through a traversal with an explicit
+    ///     stack, and the text is written in chunks of
+    ///     HDL_BUFFER_BYTES, so the dag may have millions of nodes.
+    std::ostream& write_verilog(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots,
+        std::string_view a_module
+    );
+
+    /// Writes the argued functions as a BLIF model, named
+    ///     and structured as write_verilog does, each node
+    ///     becoming a .names multiplexer. read_blif and
+    ///     build_outputs read back the same functions.
+    std::ostream& write_blif(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots,
+        std::string_view a_model
+    );
+
+    /// Writes the cover_output of each output of the argued PLA
+    ///     as a sum of products over x, assigned to y. Labels
+    ///     are written as a comment mapping them to the ports.
+    std::ostream& write_verilog(
+        std::ostream& a_ostream,
+        const pla& a_pla,
+        std::string_view a_module
+    );
+
+    /// Writes the cover_output of each output of the argued PLA
+    ///     as a .names over the inputs it depends on, named by
+    ///     the PLA's labels where it has them, and otherwise
+    ///     x[i] and y[i].
+    std::ostream& write_blif(
+        std::ostream& a_ostream,
+        const pla& a_pla,
+        std::string_view a_model
+    );
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,491 @@
+#ifndef MINIMIZE_H
+#define MINIMIZE_H
+
+#include <stdint.h>
+#include <assert.h>
+#include <bit>
+#include <limits>
+#include <array>
+#include <vector>
+#include <map>
+#include <stdexcept>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// A product term over the first six variables.
+    ///     Bit v of the care mask is set iff variable v
+    ///     appears in the term, in which case bit v of
+    ///     the value mask gives its sign.
+    class implicant
+    {
+        uint8_t m_care;
+        uint8_t m_value;
+
+        /// The minterms covered by the term, indexed
+        ///     as in truth_table_64.
+        uint64_t m_mask;
+
+    public:
+
+        implicant(
+
+        ) :
+            m_care(0),
+            m_value(0),
+            m_mask(0)
+        {
+
+        }
+
+        implicant(
+            uint8_t a_care,
+            uint8_t a_value,
+            uint64_t a_mask
+        ) :
+            m_care(a_care),
+            m_value(a_value & a_care),
+            m_mask(a_mask)
+        {
+
+        }
+
+        uint8_t care(
+
+        ) const
+        {
+            return m_care;
+        }
+
+        uint8_t value(
+
+        ) const
+        {
+            return m_value;
+        }
+
+        uint64_t mask(
+
+        ) const
+        {
+            return m_mask;
+        }
+
+        /// The number of literals in the product term.
+        int literals(
+
+        ) const
+        {
+            return std::popcount(m_care);
+        }
+
+        bool operator==(
+            const implicant& a_other
+        ) const
+        {
+            return m_care == a_other.m_care && m_value == a_other.m_value;
+        }
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// The number of variables a 64-bit truth table spans.
+    inline constexpr uint32_t TRUTH_TABLE_64_VARIABLES = 6;
+
+    /// Returns the minterms of the 6-variable space in which
+    ///     the argued variable is asserted. Variable 0 is the
+    ///     most significant bit of a minterm index, matching
+    ///     the row/column labelling of a K-map.
+    inline constexpr uint64_t variable_mask_64(
+        uint32_t a_variable_index
+    )
+    {
+        constexpr uint64_t MASKS[TRUTH_TABLE_64_VARIABLES] =
+        {
+            0xFFFFFFFF00000000ULL,
+            0xFFFF0000FFFF0000ULL,
+            0xFF00FF00FF00FF00ULL,
+            0xF0F0F0F0F0F0F0F0ULL,
+            0xCCCCCCCCCCCCCCCCULL,
+            0xAAAAAAAAAAAAAAAAULL,
+        };
+
+        return MASKS[a_variable_index];
+
+    }
+
+    inline uint64_t truth_table_64(
+        std::map<const node*, uint64_t>& a_cache,
+        const node* a_node
+    )
+    {
+        if (a_node == ZERO)
+            return 0;
+        if (a_node == ONE)
+            return ~0ULL;
+
+        /// Functions over more than six variables
+        ///     cannot be tabulated in one word.
+        if (a_node->depth() >= TRUTH_TABLE_64_VARIABLES)
+            throw std::invalid_argument("function depends on a variable past the sixth");
+
+        if (a_cache.contains(a_node))
+            return a_cache[a_node];
+
+        /// Shannon expansion over full-width tables. Skipped
+        ///     depths need no special handling, since each
+        ///     child's table already spans every variable.
+        const uint64_t l_variable_mask = variable_mask_64(a_node->depth());
+        const uint64_t l_negative = truth_table_64(a_cache, a_node->negative());
+        const uint64_t l_positive = truth_table_64(a_cache, a_node->positive());
+
+        return a_cache[a_node] =
+            (l_negative & ~l_variable_mask) | (l_positive & l_variable_mask);
+
+    }
+
+    /// Converts a function of at most six variables into its
+    ///     64-bit truth table. Functions of fewer variables
+    ///     are replicated across the unused ones.
+    ///
+    ///     Throws std::invalid_argument if the function
+    ///     depends on any later variable.
+    inline uint64_t truth_table_64(
+        const node* a_node
+    )
+    {
+        std::map<const node*, uint64_t> l_cache;
+        return truth_table_64(l_cache, a_node);
+    }
+
+    /// The number of distinct product terms over six
+    ///     variables, each variable being absent,
+    ///     complemented or uncomplemented.
+    inline constexpr size_t CUBE_COUNT_64 = 729;
+
+    /// Returns every product term over six variables, indexed
+    ///     in base three (digit v: 0 for v', 1 for v, 2 if absent).
+    inline const std::array<implicant, CUBE_COUNT_64>& cubes_64(
+
+    )
+    {
+        static const std::array<implicant, CUBE_COUNT_64> s_cubes = []
+        {
+            std::array<implicant, CUBE_COUNT_64> l_result;
+
+            for (size_t i = 0; i < CUBE_COUNT_64; i++)
+            {
+                uint8_t l_care = 0;
+                uint8_t l_value = 0;
+                uint64_t l_mask = ~0ULL;
+
+                size_t l_digits = i;
+
+                for (uint32_t v = 0; v < TRUTH_TABLE_64_VARIABLES; v++, l_digits /= 3)
+                {
+                    switch (l_digits % 3)
+                    {
+                        case 0:
+                        {
+                            l_care |= 1 << v;
+                            l_mask &= ~variable_mask_64(v);
+                            break;
+                        }
+                        case 1:
+                        {
+                            l_care |= 1 << v;
+                            l_value |= 1 << v;
+                            l_mask &= variable_mask_64(v);
+                            break;
+                        }
+                    }
+                }
+
+                l_result[i] = implicant(l_care, l_value, l_mask);
+
+            }
+
+            return l_result;
+
+        }();
+
+        return s_cubes;
+
+    }
+
+    /// Searches for a cover of a_uncovered by the argued primes,
+    ///     recording it in a_best if it is cheaper than any
+    ///     cover found so far. Cost is term count first,
+    ///     then literal count.
+    inline void minimize_64(
+        const std::vector<implicant>& a_primes,
+        const std::array<std::vector<uint32_t>, 64>& a_covering,
+        const std::array<uint64_t, 64>& a_reach,
+        const std::vector<uint32_t>& a_order,
+        uint64_t a_uncovered,
+        std::vector<uint32_t>& a_chosen,
+        int a_literals,
+        std::vector<uint32_t>& a_best,
+        int& a_best_cost
+    )
+    {
+        constexpr int TERM_COST = 1024;
+
+        if (a_uncovered == 0)
+        {
+            const int l_cost = (int)a_chosen.size() * TERM_COST + a_literals;
+
+            if (l_cost < a_best_cost)
+            {
+                a_best = a_chosen;
+                a_best_cost = l_cost;
+            }
+
+            return;
+
+        }
+
+        /// Bound by a set of uncovered minterms no two of which
+        ///     share a prime, since each needs its own term. The
+        ///     hardest-to-cover minterm heads the set and is
+        ///     the one we branch on.
+        uint32_t l_minterm = 64;
+        uint64_t l_candidates = a_uncovered;
+        int l_needed = 0;
+
+        for (uint32_t l_candidate : a_order)
+        {
+            if ((l_candidates & (1ULL << l_candidate)) == 0)
+                continue;
+
+            if (l_minterm == 64)
+                l_minterm = l_candidate;
+
+            l_candidates &= ~a_reach[l_candidate];
+            l_needed++;
+
+        }
+
+        if (((int)a_chosen.size() + l_needed) * TERM_COST + a_literals >= a_best_cost)
+            return;
+
+        /// Try the primes covering the most of the
+        ///     remaining on-set first, so a good bound
+        ///     is established early.
+        std::vector<uint32_t> l_branches = a_covering[l_minterm];
+
+        std::sort(
+            l_branches.begin(),
+            l_branches.end(),
+            [&](uint32_t a_x, uint32_t a_y)
+            {
+                return
+                    std::popcount(a_primes[a_x].mask() & a_uncovered) >
+                    std::popcount(a_primes[a_y].mask() & a_uncovered);
+            }
+        );
+
+        for (uint32_t l_branch : l_branches)
+        {
+            a_chosen.push_back(l_branch);
+
+            minimize_64(
+                a_primes,
+                a_covering,
+                a_reach,
+                a_order,
+                a_uncovered & ~a_primes[l_branch].mask(),
+                a_chosen,
+                a_literals + a_primes[l_branch].literals(),
+                a_best,
+                a_best_cost
+            );
+
+            a_chosen.pop_back();
+
+        }
+
+    }
+
+    /// Computes an exact minimum sum-of-products cover of the
+    ///     on-set, free to cover any of the don't-care set.
+    ///     Both sets are 64-bit truth tables as produced
+    ///     by truth_table_64.
+    inline std::vector<implicant> minimize_64(
+        uint64_t a_on,
+        uint64_t a_dont_care
+    )
+    {
+        const uint64_t l_allowed = a_on | a_dont_care;
+
+        if (a_on == 0)
+            return {};
+
+        const std::array<implicant, CUBE_COUNT_64>& l_cubes = cubes_64();
+
+        /// Collect the prime implicants: the allowed cubes
+        ///     touching the on-set that cannot drop a literal
+        ///     without leaving the allowed set.
+        std::vector<implicant> l_primes;
+
+        for (size_t i = 0; i < CUBE_COUNT_64; i++)
+        {
+            const implicant& l_cube = l_cubes[i];
+
+            if ((l_cube.mask() & ~l_allowed) != 0 || (l_cube.mask() & a_on) == 0)
+                continue;
+
+            bool l_prime = true;
+
+            for (size_t v = 0, l_weight = 1; v < TRUTH_TABLE_64_VARIABLES && l_prime; v++, l_weight *= 3)
+            {
+                const size_t l_digit = (i / l_weight) % 3;
+
+                if (l_digit == 2)
+                    continue;
+
+                /// The index of this cube with variable v dropped.
+                const size_t l_expanded = i + (2 - l_digit) * l_weight;
+
+                if ((l_cubes[l_expanded].mask() & ~l_allowed) == 0)
+                    l_prime = false;
+
+            }
+
+            if (l_prime)
+                l_primes.push_back(l_cube);
+
+        }
+
+        /// For each on-set minterm, list the primes covering it.
+        std::array<std::vector<uint32_t>, 64> l_covering;
+
+        for (uint32_t i = 0; i < l_primes.size(); i++)
+            for (uint64_t l_bits = l_primes[i].mask() & a_on; l_bits != 0; l_bits &= l_bits - 1)
+                l_covering[std::countr_zero(l_bits)].push_back(i);
+
+        /// The minterms sharing a prime with each minterm, and
+        ///     the on-set ordered hardest-to-cover first.
+        std::array<uint64_t, 64> l_reach = {};
+        std::vector<uint32_t> l_order;
+
+        for (uint64_t l_bits = a_on; l_bits != 0; l_bits &= l_bits - 1)
+        {
+            const uint32_t l_minterm = std::countr_zero(l_bits);
+
+            for (uint32_t l_prime : l_covering[l_minterm])
+                l_reach[l_minterm] |= l_primes[l_prime].mask();
+
+            l_order.push_back(l_minterm);
+
+        }
+
+        std::stable_sort(
+            l_order.begin(),
+            l_order.end(),
+            [&](uint32_t a_x, uint32_t a_y)
+            {
+                return l_covering[a_x].size() < l_covering[a_y].size();
+            }
+        );
+
+        /// Essential primes are the sole cover of some
+        ///     minterm, and so belong to every cover.
+        std::vector<uint32_t> l_chosen;
+        uint64_t l_uncovered = a_on;
+        int l_literals = 0;
+
+        for (uint64_t l_bits = a_on; l_bits != 0; l_bits &= l_bits - 1)
+        {
+            const std::vector<uint32_t>& l_primes_of_minterm =
+                l_covering[std::countr_zero(l_bits)];
+
+            if (l_primes_of_minterm.size() != 1)
+                continue;
+
+            const uint32_t l_essential = l_primes_of_minterm.front();
+
+            if ((l_uncovered & l_primes[l_essential].mask()) == 0)
+                continue;
+
+            l_chosen.push_back(l_essential);
+            l_uncovered &= ~l_primes[l_essential].mask();
+            l_literals += l_primes[l_essential].literals();
+
+        }
+
+        std::vector<uint32_t> l_best;
+        int l_best_cost = std::numeric_limits<int>::max();
+
+        minimize_64(
+            l_primes,
+            l_covering,
+            l_reach,
+            l_order,
+            l_uncovered,
+            l_chosen,
+            l_literals,
+            l_best,
+            l_best_cost
+        );
+
+        std::vector<implicant> l_result;
+
+        for (uint32_t l_index : l_best)
+            l_result.push_back(l_primes[l_index]);
+
+        return l_result;
+
+    }
+
+    /// Computes an exact minimum cover of a function over
+    ///     at most six variables.
+    inline std::vector<implicant> minimize_64(
+        const node* a_on,
+        const node* a_dont_care = ZERO
+    )
+    {
+        return minimize_64(truth_table_64(a_on), truth_table_64(a_dont_care));
+    }
+
+    /// Builds the disjunction of the argued product terms.
+    inline const node* realize(
+        const std::vector<implicant>& a_cover
+    )
+    {
+        const node* l_result = ZERO;
+
+        for (const implicant& l_term : a_cover)
+        {
+            const node* l_product = ONE;
+
+            for (uint32_t v = 0; v < TRUTH_TABLE_64_VARIABLES; v++)
+                if (l_term.care() & (1 << v))
+                    l_product = logic::conjoin(l_product, literal(v, l_term.value() & (1 << v)));
+
+            l_result = logic::disjoin(l_result, l_product);
+
+        }
+
+        return l_result;
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
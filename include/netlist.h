@@ -0,0 +1,124 @@
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include <stdint.h>
+#include <istream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "factor.h"
+#include "parser.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// A combinational gate-level netlist. Signal 0 is constant
+    ///     false, signals 1 through m_inputs.size() are the primary
+    ///     inputs, input i being variable i, and each later signal
+    ///     is driven by a gate. Signals are referred to by literal,
+    ///     as in AIGER: twice the signal, plus one if inverted.
+    struct netlist
+    {
+        /// Defines a single-output gate as a cover of rows over its
+        ///     fanins, written as in a PLA input plane. The rows give
+        ///     the on-set, or the off-set if m_off_set is set.
+        struct gate
+        {
+            /// Defines the fanins, m_fanins[m_first_fanin] onwards.
+            uint32_t m_first_fanin;
+            uint32_t m_fanin_count;
+
+            /// Defines the rows, m_fanin_count characters each,
+            ///     m_rows[m_first_row] onwards.
+            size_t m_first_row;
+            uint32_t m_row_count;
+
+            bool m_off_set;
+
+        };
+
+        std::vector<std::string> m_inputs;
+
+        /// Defines the outputs, by literal and by name.
+        std::vector<uint32_t> m_outputs;
+        std::vector<std::string> m_output_names;
+
+        /// Defines the gate driving signal m_inputs.size() + 1 + g.
+        std::vector<gate> m_gates;
+        std::vector<uint32_t> m_fanins;
+        std::string m_rows;
+
+        /// Defines the gates in topological order, fanins first.
+        std::vector<uint32_t> m_order;
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Reads a combinational BLIF model (.model, .inputs, .outputs
+    ///     and .names, with '\' continuing a line) into a_netlist,
+    ///     ordering its gates topologically.
+    ///
+    ///     Returns the error, its line and its position within
+    ///     the line if the text is malformed, is sequential or
+    ///     hierarchical, or has an undriven, doubly driven or
+    ///     cyclic signal, in which case a_netlist is unspecified.
+    std::optional<line_error> read_blif(
+        std::istream& a_istream,
+        netlist& a_netlist,
+        size_t a_buffer_bytes = LINE_BUFFER_BYTES
+    );
+
+    /// Reads a combinational AIGER file, ASCII ("aag") or binary
+    ///     ("aig"), including its symbol table, into a_netlist,
+    ///     ordering its gates topologically.
+    ///
+    ///     Returns the error and its offset in the stream if
+    ///     the file is malformed or has latches, in which
+    ///     case a_netlist is unspecified.
+    std::optional<parse_error> read_aiger(
+        std::istream& a_istream,
+        netlist& a_netlist
+    );
+
+    /// Defines the node count below which the private dags
+    ///     of build_outputs are never compacted.
+    inline constexpr size_t NETLIST_COMPACT_NODES = size_t(1) << 20;
+
+    /// Constructs the function of each output into the bound
+    ///     dag by symbolic simulation: each gate's function is
+    ///     built from its fanins' with the apply operators, in
+    ///     topological order, and released once its last fanout
+    ///     has used it.
+    ///
+    ///     Gates build into a private dag, which is compacted by
+    ///     transplanting the live functions into a fresh one
+    ///     whenever it exceeds a_compact_nodes and has doubled
+    ///     since the last compaction, so that released
+    ///     functions' nodes are freed. The outputs
+    ///     are split among up to a_threads threads, each building
+    ///     the cones of its outputs into its own dags; the results
+    ///     are then transplanted into the bound dag.
+    std::vector<const node*> build_outputs(
+        const netlist& a_netlist,
+        uint32_t a_threads = std::thread::hardware_concurrency(),
+        size_t a_compact_nodes = NETLIST_COMPACT_NODES
+    );
+
+    #pragma endregion
+
+}
+
+#endif
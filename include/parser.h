@@ -0,0 +1,324 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <stdint.h>
+#include <istream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    struct token
+    {
+        enum kind : uint8_t
+        {
+            VARIABLE,
+            NAME,
+            REFERENCE,
+            PRIME,
+            PLUS,
+            OPEN,
+            CLOSE,
+            END,
+            INVALID,
+        };
+
+        kind m_kind;
+
+        /// Defines the index of a VARIABLE token, or
+        ///     of the definition a REFERENCE names.
+        uint32_t m_variable_index;
+
+        /// Defines the offset of the token in the text.
+        size_t m_position;
+
+        /// Defines the text of a NAME token.
+        std::string_view m_name;
+
+    };
+
+    /// Splits an expression into tokens without copying,
+    ///     skipping whitespace. A bracketed index "[v]"
+    ///     is a single VARIABLE token, and "$k" is a
+    ///     REFERENCE to the definition k of a shared form.
+    ///
+    ///     A NAME is a letter or underscore followed by letters,
+    ///     digits and underscores, and may end in a bit index
+    ///     with no space before it, as in "bus[3]". Adjacent
+    ///     names are separated by whitespace.
+    class tokenizer
+    {
+        std::string_view m_text;
+        size_t m_position;
+
+    public:
+        tokenizer(
+            std::string_view a_text
+        ) :
+            m_text(a_text),
+            m_position(0)
+        {
+
+        }
+
+        token next(
+
+        );
+
+        /// Returns the offset just past the last token.
+        size_t position(
+
+        ) const
+        {
+            return m_position;
+        }
+
+    };
+
+    /// An expression tree stored in flat arrays: each vertex
+    ///     is a variable, the inversion of one operand, or the
+    ///     n-ary product or sum of a run of m_operands. Parsing
+    ///     hash-conses vertices, so structurally identical
+    ///     subexpressions share one vertex and are built once.
+    struct ast
+    {
+        struct vertex
+        {
+            enum kind : uint8_t
+            {
+                VARIABLE,
+                REFERENCE,
+                INVERSION,
+                PRODUCT,
+                SUM,
+            };
+
+            kind m_kind;
+
+            /// Defines the index of a VARIABLE vertex, or
+            ///     of the definition a REFERENCE names.
+            uint32_t m_variable_index;
+
+            /// Defines the operands, m_operands[m_first] onwards.
+            uint32_t m_first;
+            uint32_t m_count;
+
+        };
+
+        std::vector<vertex> m_vertices;
+        std::vector<uint32_t> m_operands;
+
+        uint32_t m_root;
+
+    };
+
+    struct parse_error
+    {
+        /// Defines the offset in the text at which
+        ///     parsing failed.
+        size_t m_position;
+
+        std::string_view m_message;
+
+    };
+
+    struct line_error
+    {
+        /// Defines the zero-based index of the line.
+        size_t m_line;
+
+        /// Defines the error, positioned within the line.
+        parse_error m_error;
+
+    };
+
+    /// Defines the size of the blocks in which
+    ///     a line_reader reads its stream.
+    inline constexpr size_t LINE_BUFFER_BYTES = size_t(1) << 20;
+
+    /// Splits a stream into lines, reading it a block at a
+    ///     time. Lines are returned as views of the block where
+    ///     possible, and are only copied when they straddle two
+    ///     blocks. A view stays valid until the next call.
+    class line_reader
+    {
+        std::istream& m_istream;
+        std::vector<char> m_buffer;
+
+        /// Defines the unread remainder of the current block.
+        std::string_view m_block;
+
+        /// Defines a line begun in an earlier block.
+        std::string m_partial;
+        bool m_partial_returned;
+
+        size_t m_lines;
+
+    public:
+        line_reader(
+            std::istream& a_istream,
+            size_t a_buffer_bytes = LINE_BUFFER_BYTES
+        ) :
+            m_istream(a_istream),
+            m_buffer(a_buffer_bytes),
+            m_partial_returned(false),
+            m_lines(0)
+        {
+
+        }
+
+        /// Reads the next line into a_line, without its newline,
+        ///     and returns false at the end of the stream. The last
+        ///     line need not end in a newline.
+        bool next(
+            std::string_view& a_line
+        );
+
+        /// Returns the number of lines read so far, so that the
+        ///     zero-based index of the last line is one less.
+        size_t lines(
+
+        ) const
+        {
+            return m_lines;
+        }
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    inline bool is_blank(
+        char a_char
+    )
+    {
+        return a_char == ' ' || a_char == '\t' || a_char == '\r';
+    }
+
+    /// Returns the next whitespace-delimited word of the
+    ///     line, stepping a_position past it.
+    inline std::string_view next_word(
+        std::string_view a_line,
+        size_t& a_position
+    )
+    {
+        while (a_position < a_line.size() && is_blank(a_line[a_position]))
+            a_position++;
+
+        const size_t l_start = a_position;
+
+        while (a_position < a_line.size() && !is_blank(a_line[a_position]))
+            a_position++;
+
+        return a_line.substr(l_start, a_position - l_start);
+
+    }
+
+    /// Parses the argued expression, in the notation written
+    ///     by operator<<, into a_ast. Postfix "'" binds tightest,
+    ///     then juxtaposition (conjunction), then "+". An empty
+    ///     product, such as "()", is ONE. Names are interned
+    ///     into a_symbols, a new name never taking an index the
+    ///     text also writes as "[i]".
+    ///
+    ///     Returns the error and its position if the text
+    ///     is malformed, in which case a_ast is unspecified.
+    std::optional<parse_error> parse(
+        std::string_view a_text,
+        ast& a_ast,
+        symbol_table& a_symbols
+    );
+
+    /// Parses as above, interning names into
+    ///     the bound dag's symbol table.
+    std::optional<parse_error> parse(
+        std::string_view a_text,
+        ast& a_ast
+    );
+
+    /// Constructs the function of the argued tree into the
+    ///     bound dag. Products of literals are built directly
+    ///     as cubes, and the remaining operands of each product
+    ///     or sum are folded from the right, f + (g + ...).
+    ///     A reference "$k" stands for a_definitions[k].
+    const node* build(
+        const ast& a_ast,
+        std::span<const node* const> a_definitions = {}
+    );
+
+    /// Reads a function in the shared form written by
+    ///     print_shared into the bound dag, interning names
+    ///     into its symbol table. Each definition "$k = ..."
+    ///     must be numbered in turn and may refer only to
+    ///     earlier ones; blank lines are skipped.
+    ///
+    ///     Returns the error, its line and its position within
+    ///     the line if the text is malformed, in which case
+    ///     a_node is unspecified.
+    std::optional<line_error> read_shared(
+        std::istream& a_istream,
+        const node*& a_node,
+        size_t a_buffer_bytes = LINE_BUFFER_BYTES
+    );
+
+    /// Defines the size of the window of a file mapped
+    ///     at any one time by load_expression.
+    inline constexpr size_t LOAD_CHUNK_BYTES = size_t(64) << 20;
+
+    /// Parses the expression in the file at a_path into the
+    ///     bound dag, interning names into its symbol table, and
+    ///     mapping the file a_chunk_bytes at a time. Each
+    ///     product and sum is constructed as soon as it closes,
+    ///     so memory is proportional to the dag and the depth
+    ///     of nesting rather than to the text. The file is read
+    ///     twice, first for the indices it writes as "[i]", which
+    ///     new names do not take.
+    ///
+    ///     Returns the error and its offset in the file if the
+    ///     text is malformed. Throws std::system_error if the
+    ///     file cannot be opened or mapped.
+    std::optional<parse_error> load_expression(
+        const char* a_path,
+        const node*& a_node,
+        size_t a_chunk_bytes = LOAD_CHUNK_BYTES
+    );
+
+    /// Parses each line of the argued text as an expression,
+    ///     across up to a_threads threads, and returns their roots
+    ///     in the bound dag in input order. Each thread builds into
+    ///     a private dag, and these are then transplanted into the
+    ///     bound dag, sharing what the lines have in common. Names
+    ///     are interned into the bound dag's symbol table in line
+    ///     order before the threads start, so the indices of new
+    ///     names do not depend on the number of threads.
+    ///
+    ///     A trailing newline does not begin another line. Lines
+    ///     that fail to parse are appended to a_errors in line
+    ///     order, and their roots are ZERO.
+    std::vector<const node*> parse_lines(
+        std::string_view a_text,
+        std::vector<line_error>& a_errors,
+        uint32_t a_threads = std::thread::hardware_concurrency()
+    );
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PLA_H
+#define PLA_H
+
+#include <stdint.h>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "factor.h"
+#include "parser.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// A multiple-output function in the Berkeley (espresso)
+    ///     PLA format. Input v of the PLA is variable v.
+    struct pla
+    {
+        uint32_t m_inputs = 0;
+
+        /// Defines the names given by .ilb and .ob,
+        ///     which are empty if none were given.
+        std::vector<std::string> m_input_labels;
+        std::vector<std::string> m_output_labels;
+
+        /// Defines the on-set and don't-care set of each
+        ///     output in the bound dag. The sets of an
+        ///     output are disjoint.
+        std::vector<const node*> m_on;
+        std::vector<const node*> m_dont_care;
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Defines the size of the blocks in which
+    ///     PLAs are read and written.
+    inline constexpr size_t PLA_BUFFER_BYTES = size_t(1) << 20;
+
+    /// Reads a PLA into a_pla, a_buffer_bytes at a time, keeping
+    ///     only the input planes of the cubes. Once the input ends
+    ///     (or at .e), each output's sets are constructed with
+    ///     from_cubes, one call per set rather than one
+    ///     disjunction per cube.
+    ///
+    ///     Supports .i, .o, .ilb, .ob, .p and .type f, fd, fr
+    ///     and fdr, the default being fd. Other directives are
+    ///     ignored. Under fr and fdr, minterms in no set are
+    ///     don't-cares, and minterms in both the on-set and
+    ///     the off-set are on.
+    ///
+    ///     Returns the error, its line and its position within
+    ///     the line if the text is malformed, in which case
+    ///     a_pla is unspecified.
+    std::optional<line_error> read_pla(
+        std::istream& a_istream,
+        pla& a_pla,
+        size_t a_buffer_bytes = PLA_BUFFER_BYTES
+    );
+
+    /// Returns the input planes of a cover of the argued output
+    ///     of the PLA, free to cover any of its don't-cares. PLAs
+    ///     of at most six inputs are minimized exactly by
+    ///     minimize_64; larger ones receive an irredundant cover.
+    std::vector<std::string> cover_output(
+        const pla& a_pla,
+        size_t a_output
+    );
+
+    /// Writes the cover_output of each output of the argued
+    ///     PLA, merging cubes shared between outputs into
+    ///     one line.
+    std::ostream& write_pla(
+        std::ostream& a_ostream,
+        const pla& a_pla
+    );
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <stdint.h>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <span>
+#include <vector>
+
+#include "factor.h"
+#include "parser.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// The computed tables saved with a checkpoint: the caches
+    ///     passed to join and to invert, in a fixed order, so that
+    ///     a resumed job finds the results it had computed.
+    struct checkpoint_tables
+    {
+        std::vector<std::map<std::set<const node*>, const node*>*> m_joins;
+        std::vector<std::map<const node*, const node*>*> m_inversions;
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Defines the size of the chunks in which
+    ///     dags are written and read.
+    inline constexpr size_t SERIALIZE_BUFFER_BYTES = size_t(1) << 20;
+
+    /// Writes the nodes beneath the argued roots in binary, every
+    ///     integer being an unsigned LEB128 varint:
+    ///
+    ///         "FDAG", a version byte of 1, then the counts of
+    ///             nodes, levels, roots and variable names;
+    ///         each name of a variable up to the deepest written,
+    ///             as its index, its length and its bytes;
+    ///         each level, deepest first, as its depth (for the
+    ///             first) or its distance above the previous one,
+    ///             its node count, and then each node's negative
+    ///             and positive child;
+    ///         each root.
+    ///
+    ///     As children lie deeper than their parents, every child
+    ///     is written before its parents. Nodes are numbered from
+    ///     0 in the order written, and a node is referred to as 0
+    ///     for ZERO, 1 for ONE, and otherwise as 1 more than the
+    ///     distance back to it from its parent, or as 2 more than
+    ///     its number from the root table.
+    ///
+    ///     The text is written in chunks of SERIALIZE_BUFFER_BYTES.
+    std::ostream& write_binary(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots
+    );
+
+    /// Reads a dag written by write_binary into the bound dag,
+    ///     rebuilding each node through emplace and assigning the
+    ///     names into its symbol table, and sets a_roots to its
+    ///     roots, a_buffer_bytes being read at a time.
+    ///
+    ///     Returns the error and its offset in the stream if the
+    ///     data is malformed or truncated, a child does not lie
+    ///     deeper than its parent, or a name conflicts with the
+    ///     bound dag's, in which case a_roots is unspecified and
+    ///     no name is assigned.
+    std::optional<parse_error> read_binary(
+        std::istream& a_istream,
+        std::vector<const node*>& a_roots,
+        size_t a_buffer_bytes = SERIALIZE_BUFFER_BYTES
+    );
+
+    /// Writes every node of a_dag, the names of all its variables,
+    ///     the argued roots and the argued tables, so that a job
+    ///     can later resume from them. The layout is that of
+    ///     write_binary, beginning "FCKP", followed by the count
+    ///     of join tables, each as its entry count and each entry
+    ///     as its operand count, its operands and its result, and
+    ///     then likewise the inversion tables, each entry as its
+    ///     operand and its result, nodes being referred to as
+    ///     from the root table.
+    ///
+    ///     Within a level, nodes are numbered in the order of their
+    ///     children's numbers, so the numbering depends only on the
+    ///     functions held: restoring a checkpoint into an empty dag
+    ///     and writing it again gives the same bytes, and each
+    ///     node keeps its number across any number of restarts.
+    ///
+    ///     Throws std::out_of_range if a table refers to a
+    ///     node outside a_dag.
+    std::ostream& write_checkpoint(
+        std::ostream& a_ostream,
+        const dag& a_dag,
+        std::span<const node* const> a_roots,
+        const checkpoint_tables& a_tables
+    );
+
+    /// Writes a checkpoint to a_path by way of a_path with ".tmp"
+    ///     appended, which is flushed to disk and then renamed over
+    ///     a_path, the directory being flushed after, so a crash
+    ///     leaves either the previous checkpoint or the new one
+    ///     whole, and the new one once this returns.
+    ///
+    ///     Throws std::system_error if the file cannot be written,
+    ///     and std::out_of_range as write_checkpoint does, in
+    ///     either case removing the partial file.
+    void save_checkpoint(
+        const char* a_path,
+        const dag& a_dag,
+        std::span<const node* const> a_roots,
+        const checkpoint_tables& a_tables
+    );
+
+    /// Reads a checkpoint written by write_checkpoint into the
+    ///     bound dag, as read_binary does, sets a_roots to its roots
+    ///     and adds the saved entries to the argued tables, which
+    ///     must be as many as were saved, translated to the
+    ///     rebuilt nodes.
+    ///
+    ///     Returns the error and its offset in the stream if the
+    ///     data is malformed or truncated or the table counts
+    ///     differ, in which case a_roots and the tables are
+    ///     unspecified and no name is assigned.
+    std::optional<parse_error> read_checkpoint(
+        std::istream& a_istream,
+        std::vector<const node*>& a_roots,
+        const checkpoint_tables& a_tables,
+        size_t a_buffer_bytes = SERIALIZE_BUFFER_BYTES
+    );
+
+    /// Reads the checkpoint at a_path, as read_checkpoint does.
+    ///
+    ///     Throws std::system_error if the file cannot be opened.
+    std::optional<parse_error> load_checkpoint(
+        const char* a_path,
+        std::vector<const node*>& a_roots,
+        const checkpoint_tables& a_tables
+    );
+
+    #pragma endregion
+
+}
+
+#endif
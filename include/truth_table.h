@@ -0,0 +1,444 @@
+#ifndef TRUTH_TABLE_H
+#define TRUTH_TABLE_H
+
+#include <stdint.h>
+#include <assert.h>
+#include <string.h>
+#include <array>
+#include <span>
+#include <vector>
+#include <string_view>
+#include <stdexcept>
+#include <unordered_map>
+#include <thread>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Dense truth tables are packed 64 minterms per word, minterm
+    ///     i being bit i % 64 of word i / 64. As in truth_table_64,
+    ///     variable 0 is the most significant bit of a minterm index,
+    ///     so the table of a node at depth d is its negative child's
+    ///     table followed by its positive child's.
+    inline constexpr uint32_t TRUTH_TABLE_MAX_VARIABLES = 30;
+
+    /// The number of words in a dense table over n variables.
+    inline size_t truth_table_words(
+        uint32_t a_variables
+    )
+    {
+        return a_variables <= 6 ? 1 : (size_t)1 << (a_variables - 6);
+    }
+
+    /// Memoized expansion state, private to one thread.
+    struct truth_table_expansion
+    {
+        uint32_t m_variables;
+
+        /// Where the table of a node, over the variables from
+        ///     its own depth on, was first written. Only tables
+        ///     spanning whole words are recorded.
+        std::unordered_map<const node*, const uint64_t*> m_blocks;
+
+        /// The table of a node over the variables from its own
+        ///     depth on, for tables narrower than one word.
+        std::unordered_map<const node*, uint64_t> m_patterns;
+
+    };
+
+    /// Returns the table of a_node over variables [a_depth, n),
+    ///     where that table spans at most 64 bits.
+    inline uint64_t expand_pattern(
+        truth_table_expansion& a_expansion,
+        const node* a_node,
+        uint32_t a_depth
+    )
+    {
+        const uint32_t l_width = 1U << (a_expansion.m_variables - a_depth);
+        const uint64_t l_full = l_width == 64 ? ~0ULL : (1ULL << l_width) - 1;
+
+        if (a_node == ZERO)
+            return 0;
+        if (a_node == ONE)
+            return l_full;
+
+        assert(a_node->depth() < a_expansion.m_variables);
+
+        uint64_t l_pattern;
+
+        if (a_expansion.m_patterns.contains(a_node))
+        {
+            l_pattern = a_expansion.m_patterns[a_node];
+        }
+        else
+        {
+            const uint32_t l_half = 1U << (a_expansion.m_variables - a_node->depth() - 1);
+
+            l_pattern =
+                expand_pattern(a_expansion, a_node->negative(), a_node->depth() + 1) |
+                expand_pattern(a_expansion, a_node->positive(), a_node->depth() + 1) << l_half;
+
+            a_expansion.m_patterns[a_node] = l_pattern;
+
+        }
+
+        /// Replicate across the depths the node skips.
+        for (uint32_t l_span = 1U << (a_expansion.m_variables - a_node->depth()); l_span < l_width; l_span *= 2)
+            l_pattern |= l_pattern << l_span;
+
+        return l_pattern;
+
+    }
+
+    /// Writes the table of a_node over variables [a_depth, n)
+    ///     into a_output, which spans 2^(n - a_depth) bits
+    ///     (its low bits, if that is less than a word).
+    inline void expand(
+        truth_table_expansion& a_expansion,
+        const node* a_node,
+        uint32_t a_depth,
+        uint64_t* a_output
+    )
+    {
+        const uint32_t l_remaining = a_expansion.m_variables - a_depth;
+
+        if (l_remaining <= 6)
+        {
+            *a_output = expand_pattern(a_expansion, a_node, a_depth);
+            return;
+        }
+
+        const size_t l_words = (size_t)1 << (l_remaining - 6);
+
+        if (a_node == ZERO || a_node == ONE)
+        {
+            memset(a_output, a_node == ONE ? 0xFF : 0x00, l_words * sizeof(uint64_t));
+            return;
+        }
+
+        assert(a_node->depth() < a_expansion.m_variables);
+
+        /// Expand the node at its own depth into the first
+        ///     block, then replicate that block across the
+        ///     depths skipped by doubling copies.
+        const uint32_t l_own_remaining = a_expansion.m_variables - a_node->depth();
+
+        if (l_own_remaining <= 6)
+        {
+            const uint64_t l_pattern = expand_pattern(a_expansion, a_node, a_depth + l_remaining - 6);
+
+            for (size_t i = 0; i < l_words; i++)
+                a_output[i] = l_pattern;
+
+            return;
+        }
+
+        const size_t l_own_words = (size_t)1 << (l_own_remaining - 6);
+
+        if (a_expansion.m_blocks.contains(a_node))
+        {
+            memcpy(a_output, a_expansion.m_blocks[a_node], l_own_words * sizeof(uint64_t));
+        }
+        else
+        {
+            expand(a_expansion, a_node->negative(), a_node->depth() + 1, a_output);
+            expand(a_expansion, a_node->positive(), a_node->depth() + 1, a_output + l_own_words / 2);
+
+            a_expansion.m_blocks[a_node] = a_output;
+
+        }
+
+        for (size_t l_filled = l_own_words; l_filled < l_words; l_filled *= 2)
+            memcpy(a_output + l_filled, a_output, l_filled * sizeof(uint64_t));
+
+    }
+
+    /// Expands the function into its dense truth table over
+    ///     variables [0, a_variables). The top levels are split
+    ///     across up to a_threads threads, each expanding its
+    ///     share of the table with its own memo.
+    ///
+    ///     Throws std::invalid_argument if a_variables exceeds
+    ///     TRUTH_TABLE_MAX_VARIABLES.
+    inline std::vector<uint64_t> expand(
+        const node* a_root,
+        uint32_t a_variables,
+        uint32_t a_threads = std::thread::hardware_concurrency()
+    )
+    {
+        if (a_variables > TRUTH_TABLE_MAX_VARIABLES)
+            throw std::invalid_argument("too many variables for a dense truth table");
+
+        std::vector<uint64_t> l_result(truth_table_words(a_variables), 0);
+
+        /// Split on as many top variables as needed to occupy
+        ///     the threads, keeping each share word-aligned.
+        uint32_t l_split = 0;
+
+        while ((1U << l_split) < a_threads && a_variables - l_split > 12)
+            l_split++;
+
+        if (l_split == 0)
+        {
+            truth_table_expansion l_expansion{ a_variables };
+            expand(l_expansion, a_root, 0, l_result.data());
+            return l_result;
+        }
+
+        const size_t l_share_words = l_result.size() >> l_split;
+
+        const auto l_expand_shares = [&](uint32_t a_first)
+        {
+            truth_table_expansion l_expansion{ a_variables };
+
+            for (uint32_t l_share = a_first; l_share < (1U << l_split); l_share += a_threads)
+            {
+                /// Follow the share's assignment of the split
+                ///     variables, variable 0 being its top bit.
+                const node* l_node = a_root;
+
+                while (l_node != ZERO && l_node != ONE && l_node->depth() < l_split)
+                {
+                    const bool l_value = (l_share >> (l_split - 1 - l_node->depth())) & 1;
+                    l_node = l_value ? l_node->positive() : l_node->negative();
+                }
+
+                expand(l_expansion, l_node, l_split, l_result.data() + l_share * l_share_words);
+
+            }
+        };
+
+        std::vector<std::thread> l_threads;
+
+        for (uint32_t i = 0; i < a_threads && i < (1U << l_split); i++)
+            l_threads.emplace_back(l_expand_shares, i);
+
+        for (std::thread& l_thread : l_threads)
+            l_thread.join();
+
+        return l_result;
+
+    }
+
+    /// Parses a truth table written as one hexadecimal number,
+    ///     most significant digit first, whose bit i is minterm i.
+    ///     Throws std::invalid_argument if a_variables exceeds
+    ///     TRUTH_TABLE_MAX_VARIABLES or the text is malformed.
+    inline std::vector<uint64_t> truth_table_from_hex(
+        std::string_view a_hex,
+        uint32_t a_variables
+    )
+    {
+        if (a_variables > TRUTH_TABLE_MAX_VARIABLES)
+            throw std::invalid_argument("too many variables for a dense truth table");
+
+        const size_t l_digits = a_variables < 2 ? 1 : (size_t)1 << (a_variables - 2);
+
+        if (a_hex.starts_with("0x") || a_hex.starts_with("0X"))
+            a_hex.remove_prefix(2);
+
+        if (a_hex.size() != l_digits)
+            throw std::invalid_argument("truth table has the wrong number of digits");
+
+        std::vector<uint64_t> l_result(truth_table_words(a_variables), 0);
+
+        for (size_t i = 0; i < l_digits; i++)
+        {
+            const char l_char = a_hex[l_digits - 1 - i];
+
+            uint64_t l_digit;
+
+            if (l_char >= '0' && l_char <= '9')
+                l_digit = l_char - '0';
+            else if (l_char >= 'a' && l_char <= 'f')
+                l_digit = l_char - 'a' + 10;
+            else if (l_char >= 'A' && l_char <= 'F')
+                l_digit = l_char - 'A' + 10;
+            else
+                throw std::invalid_argument("truth table has a non-hexadecimal digit");
+
+            l_result[i / 16] |= l_digit << (4 * (i % 16));
+
+        }
+
+        /// A single digit over-covers tables of fewer than
+        ///     two variables.
+        if (a_variables < 2)
+            l_result[0] &= (1ULL << (1U << a_variables)) - 1;
+
+        return l_result;
+
+    }
+
+    /// Per sub-table width (as log2 of the bit count), the
+    ///     nodes already built for each bit pattern.
+    typedef std::array<std::unordered_map<uint64_t, const node*>, 7> truth_table_patterns;
+
+    /// Builds the node for the table of 2^a_width_log2 bits held in
+    ///     the low bits of a_pattern, over variables from a_depth on.
+    inline const node* from_pattern(
+        dag& a_dag,
+        truth_table_patterns& a_patterns,
+        uint64_t a_pattern,
+        uint32_t a_width_log2,
+        uint32_t a_depth
+    )
+    {
+        const uint64_t l_full =
+            a_width_log2 == 6 ? ~0ULL : (1ULL << (1U << a_width_log2)) - 1;
+
+        if (a_pattern == 0)
+            return ZERO;
+        if (a_pattern == l_full)
+            return ONE;
+
+        std::unordered_map<uint64_t, const node*>& l_memo = a_patterns[a_width_log2];
+
+        if (l_memo.contains(a_pattern))
+            return l_memo[a_pattern];
+
+        const uint32_t l_half = 1U << (a_width_log2 - 1);
+
+        const node* l_negative =
+            from_pattern(a_dag, a_patterns, a_pattern & (l_full >> l_half), a_width_log2 - 1, a_depth + 1);
+        const node* l_positive =
+            from_pattern(a_dag, a_patterns, a_pattern >> l_half, a_width_log2 - 1, a_depth + 1);
+
+        return l_memo[a_pattern] = a_dag.emplace(a_depth, l_negative, l_positive);
+
+    }
+
+    /// Builds the reduced DAG of a table over variables [a_depth, n)
+    ///     into a_dag. Each word is built once per distinct pattern,
+    ///     and the levels above are paired bottom-up, emplace
+    ///     hash-consing identical sub-tables as it goes.
+    inline const node* from_truth_table(
+        dag& a_dag,
+        std::span<const uint64_t> a_table,
+        uint32_t a_variables,
+        uint32_t a_depth
+    )
+    {
+        truth_table_patterns l_patterns;
+
+        const uint32_t l_remaining = a_variables - a_depth;
+
+        if (l_remaining <= 6)
+        {
+            const uint64_t l_full = l_remaining == 6 ? ~0ULL : (1ULL << (1U << l_remaining)) - 1;
+            return from_pattern(a_dag, l_patterns, a_table[0] & l_full, l_remaining, a_depth);
+        }
+
+        std::vector<const node*> l_level(a_table.size());
+
+        for (size_t i = 0; i < a_table.size(); i++)
+            l_level[i] = from_pattern(a_dag, l_patterns, a_table[i], 6, a_variables - 6);
+
+        /// Adjacent sub-tables differ in the variable just
+        ///     above them, the even one being its negative case.
+        for (uint32_t l_depth = a_variables - 6; l_depth-- > a_depth; )
+        {
+            for (size_t i = 0; i < l_level.size() / 2; i++)
+                l_level[i] = a_dag.emplace(l_depth, l_level[2 * i], l_level[2 * i + 1]);
+
+            l_level.resize(l_level.size() / 2);
+
+        }
+
+        return l_level.front();
+
+    }
+
+    /// Tables of at least this many variables are
+    ///     built by several threads.
+    inline constexpr uint32_t TRUTH_TABLE_PARALLEL_VARIABLES = 24;
+
+    /// Builds the function whose dense truth table over variables
+    ///     [0, a_variables) is argued, into the bound dag, in time
+    ///     linear in the table. Large tables are split on their top
+    ///     variables across up to a_threads threads, each building
+    ///     its share into a private dag that is then transplanted.
+    ///
+    ///     Throws std::invalid_argument if a_variables exceeds
+    ///     TRUTH_TABLE_MAX_VARIABLES or the table is not
+    ///     truth_table_words(a_variables) words long.
+    inline const node* from_truth_table(
+        std::span<const uint64_t> a_table,
+        uint32_t a_variables,
+        uint32_t a_threads = std::thread::hardware_concurrency()
+    )
+    {
+        if (a_variables > TRUTH_TABLE_MAX_VARIABLES)
+            throw std::invalid_argument("too many variables for a dense truth table");
+
+        if (a_table.size() != truth_table_words(a_variables))
+            throw std::invalid_argument("truth table has the wrong number of words");
+
+        dag& l_dag = *global_node_sink::bound();
+
+        uint32_t l_split = 0;
+
+        if (a_variables >= TRUTH_TABLE_PARALLEL_VARIABLES)
+            while ((1U << l_split) < a_threads && a_variables - l_split > 12)
+                l_split++;
+
+        if (l_split == 0)
+            return from_truth_table(l_dag, a_table, a_variables, 0);
+
+        const size_t l_share_words = a_table.size() >> l_split;
+
+        std::vector<dag> l_share_dags(1U << l_split);
+        std::vector<const node*> l_level(1U << l_split);
+
+        const auto l_build_shares = [&](uint32_t a_first)
+        {
+            for (uint32_t l_share = a_first; l_share < l_level.size(); l_share += a_threads)
+                l_level[l_share] =
+                    from_truth_table(
+                        l_share_dags[l_share],
+                        a_table.subspan(l_share * l_share_words, l_share_words),
+                        a_variables,
+                        l_split
+                    );
+        };
+
+        std::vector<std::thread> l_threads;
+
+        for (uint32_t i = 0; i < a_threads && i < l_level.size(); i++)
+            l_threads.emplace_back(l_build_shares, i);
+
+        for (std::thread& l_thread : l_threads)
+            l_thread.join();
+
+        /// Move the shares into the bound dag, sharing what
+        ///     they have in common, and join the top levels.
+        std::map<const node*, const node*> l_cache;
+
+        for (const node*& l_root : l_level)
+            l_root = transplant(l_cache, l_root);
+
+        for (uint32_t l_depth = l_split; l_depth-- > 0; )
+        {
+            for (size_t i = 0; i < l_level.size() / 2; i++)
+                l_level[i] = l_dag.emplace(l_depth, l_level[2 * i], l_level[2 * i + 1]);
+
+            l_level.resize(l_level.size() / 2);
+
+        }
+
+        return l_level.front();
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <stdint.h>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// Defines the size at which an expression_writer
+    ///     flushes its buffer to its stream.
+    inline constexpr size_t WRITER_BUFFER_BYTES = size_t(1) << 20;
+
+    /// Writes functions in the notation of operator<<, byte
+    ///     for byte, for bulk exports. Text is rendered into a
+    ///     buffer that is flushed to the stream in chunks of about
+    ///     a_buffer_bytes, nodes are visited with an explicit stack
+    ///     rather than by recursion, and indices are formatted with
+    ///     std::to_chars. The buffer and stack are kept between
+    ///     writes, so once they have grown, writing allocates
+    ///     nothing. Whatever remains is flushed on destruction.
+    class expression_writer
+    {
+        struct frame
+        {
+            const node* m_node;
+
+            /// Defines how much of the node has been
+            ///     written: nothing, its negative case,
+            ///     or both of its cases.
+            uint8_t m_stage;
+
+        };
+
+        std::ostream& m_ostream;
+
+        /// Defines the names to write variables by, if any.
+        const symbol_table* m_symbols;
+
+        size_t m_buffer_bytes;
+
+        std::string m_buffer;
+        std::vector<frame> m_stack;
+
+        /// Writes the argued variable as print does,
+        ///     returning whether it was written by name.
+        bool write_variable(
+            uint32_t a_variable_index
+        );
+
+    public:
+        expression_writer(
+            std::ostream& a_ostream,
+            size_t a_buffer_bytes = WRITER_BUFFER_BYTES
+        );
+
+        /// Writes each variable that has a name in
+        ///     a_symbols by that name, as print does.
+        expression_writer(
+            std::ostream& a_ostream,
+            const symbol_table& a_symbols,
+            size_t a_buffer_bytes = WRITER_BUFFER_BYTES
+        );
+
+        expression_writer(
+            const expression_writer&
+        ) = delete;
+
+        ~expression_writer(
+
+        );
+
+        /// Writes the argued function as operator<< would.
+        expression_writer& write(
+            const node* a_node
+        );
+
+        /// Writes the argued text verbatim, such
+        ///     as a separator between functions.
+        expression_writer& write(
+            std::string_view a_text
+        );
+
+        /// Writes the buffered text to the stream.
+        void flush(
+
+        );
+
+    };
+
+    #pragma endregion
+
+}
+
+#endif
@@ -1,8 +1,30 @@
 #include <iostream>
 #include <assert.h>
 #include <sstream>
+#include <chrono>
+#include <random>
+#include <string_view>
+#include <fstream>
+#include <filesystem>
+#include <charconv>
+#include <cstring>
+#include <functional>
 
 #include "include/factor.h"
+#include "include/minimize.h"
+#include "include/evaluator.h"
+#include "include/codegen.h"
+#include "include/truth_table.h"
+#include "include/cover.h"
+#include "include/parser.h"
+#include "include/pla.h"
+#include "include/cnf.h"
+#include "include/netlist.h"
+#include "include/writer.h"
+#include "include/dot.h"
+#include "include/hdl.h"
+#include "include/serialize.h"
+#include "include/frozen.h"
 
 #define LOG(x) if (ENABLE_DEBUG_LOGS) std::cout << x;
 
@@ -296,6 +318,78 @@ void test_literal(
     
 }
 
+void test_cube(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// The literals may be given in any order.
+    const std::pair<uint32_t, bool> l_literals[] = { { 2, true }, { 0, false }, { 5, true } };
+
+    const node* l_cube = cube(l_literals);
+
+    assert(l_nodes.size() == 3);
+    assert(l_cube == conjoin(conjoin(literal(0, false), literal(2, true)), literal(5, true)));
+
+    /// The chain is emplaced in depth order.
+    assert(l_cube->depth() == 0);
+    assert(l_cube->negative()->depth() == 2);
+    assert(l_cube->negative()->positive()->depth() == 5);
+
+    /// Repeated literals are absorbed.
+    const std::pair<uint32_t, bool> l_repeated[] = { { 5, true }, { 2, true }, { 5, true }, { 0, false } };
+
+    assert(cube(l_repeated) == l_cube);
+
+    /// Contradictions are ZERO, and nothing is emplaced.
+    const size_t l_size = l_nodes.size();
+
+    const std::pair<uint32_t, bool> l_contradiction[] = { { 1, true }, { 3, false }, { 1, false } };
+
+    assert(cube(l_contradiction) == ZERO);
+    assert(l_nodes.size() == l_size);
+
+    /// The empty product is ONE.
+    assert(cube({}) == ONE);
+
+    /// A single literal is just the literal.
+    const std::pair<uint32_t, bool> l_single[] = { { 4, false } };
+
+    assert(cube(l_single) == literal(4, false));
+
+}
+
+void test_clause(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const std::pair<uint32_t, bool> l_literals[] = { { 2, true }, { 0, false }, { 5, true }, { 2, true } };
+
+    const node* l_clause = clause(l_literals);
+
+    assert(l_clause == disjoin(disjoin(literal(0, false), literal(2, true)), literal(5, true)));
+
+    /// A clause is the inversion of the product
+    ///     of its inverted literals.
+    const std::pair<uint32_t, bool> l_inverted[] = { { 2, false }, { 0, true }, { 5, false } };
+
+    assert(l_clause == invert(cube(l_inverted)));
+
+    /// Tautologies are ONE, and the empty sum is ZERO.
+    const std::pair<uint32_t, bool> l_tautology[] = { { 3, true }, { 1, false }, { 3, false } };
+
+    assert(clause(l_tautology) == ONE);
+    assert(clause({}) == ZERO);
+
+}
+
 void test_dag_logic_padding(
 
 )
@@ -857,6 +951,33 @@ void test_evaluate(
     assert(evaluate(l_function_1, { 1, 0, 1, 1, 1, 0 }) == false);
     assert(evaluate(l_function_1, { 1, 0, 1, 1, 0, 1 }) == true);
 
+    /// The packed overloads agree with the unpacked one.
+    for (uint64_t i = 0; i < 64; i++)
+    {
+        std::vector<bool> l_input(6);
+
+        for (uint32_t v = 0; v < 6; v++)
+            l_input[v] = (i >> v) & 1;
+
+        const bool l_desired = evaluate(l_function_0, l_input);
+
+        assert(evaluate(l_function_0, std::span(&i, 1)) == l_desired);
+        assert(evaluate(l_function_0, std::bitset<6>(i)) == l_desired);
+
+    }
+
+    /// Variables in later words of the packed input.
+    const node* l_function_2 = conjoin(l_a, literal(64, true), literal(129, false));
+
+    assert(evaluate(l_function_2, std::vector<uint64_t>{ 1, 1, 0 }) == true);
+    assert(evaluate(l_function_2, std::vector<uint64_t>{ 1, 1, 2 }) == false);
+    assert(evaluate(l_function_2, std::vector<uint64_t>{ 1, 0, 0 }) == false);
+    assert(evaluate(l_function_2, std::bitset<130>().set(0).set(64)) == true);
+    assert(evaluate(l_function_2, std::bitset<130>().set(0).set(64).set(129)) == false);
+
+    assert(evaluate(ONE, std::span<const uint64_t>()) == true);
+    assert(evaluate(ZERO, std::bitset<1>()) == false);
+
 }
 
 void test_node_istream_extractor(
@@ -1283,36 +1404,3990 @@ void test_node_istream_extractor(
 
 }
 
-void unit_test_main(
+void test_truth_table_64(
 
 )
 {
-    constexpr bool ENABLE_DEBUG_LOGS = true;
+    dag l_nodes;
 
-    TEST(test_node_constructor);
-    TEST(test_node_less_than_comparison);
-    TEST(test_node_ostream_inserter);
-    TEST(test_cache_macro);
-    TEST(test_node_contraction);
-    TEST(test_global_node_sink_bind);
-    TEST(test_global_node_sink_emplace);
-    TEST(test_literal);
-    TEST(test_dag_logic_padding);
-    TEST(test_dag_logic_invert);
-    TEST(test_dag_logic_join);
-    TEST(test_demorgans);
-    TEST(test_composite_function_logic);
-    TEST(test_equivalent_functions);
-    TEST(test_evaluate);
-    TEST(test_node_istream_extractor);
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_f = literal(5, true);
+
+    assert(truth_table_64(ZERO) == 0);
+    assert(truth_table_64(ONE) == ~0ULL);
+
+    /// Variable 0 is the most significant minterm bit.
+    assert(truth_table_64(l_a) == 0xFFFFFFFF00000000ULL);
+    assert(truth_table_64(invert(l_f)) == 0x5555555555555555ULL);
+    assert(truth_table_64(conjoin(l_a, l_b)) == 0xFFFF000000000000ULL);
+    assert(truth_table_64(exor(l_a, l_f)) == 0x55555555AAAAAAAAULL);
+
+    /// Check against evaluate over the whole space.
+    const node* l_function =
+        disjoin(conjoin(l_a, invert(l_b)), conjoin(literal(3, true), l_f));
+
+    const uint64_t l_table = truth_table_64(l_function);
+
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        std::vector<bool> l_input(6);
+
+        for (uint32_t v = 0; v < 6; v++)
+            l_input[v] = (i >> (5 - v)) & 1;
+
+        assert(evaluate(l_function, l_input) == (((l_table >> i) & 1) != 0));
+        
+    }
+
+    /// A function of a seventh variable is refused.
+    bool l_thrown = false;
+
+    try
+    {
+        truth_table_64(conjoin(l_a, literal(6, true)));
+    }
+    catch (const std::invalid_argument&)
+    {
+        l_thrown = true;
+    }
+
+    assert(l_thrown);
     
 }
 
-#pragma endregion
+void test_minimize_64(
 
-int main(
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::vector<const node*> l_vars;
+
+    for (uint32_t i = 0; i < 6; i++)
+        l_vars.push_back(literal(i, true));
+
+    assert(cubes_64().size() == 729);
+
+    assert(minimize_64(ZERO).empty());
+
+    {
+        std::vector<implicant> l_cover = minimize_64(ONE);
+        assert(l_cover.size() == 1);
+        assert(l_cover[0].care() == 0);
+    }
+
+    {
+        const node* l_function = exor(l_vars[0], l_vars[1]);
+        std::vector<implicant> l_cover = minimize_64(l_function);
+        assert(l_cover.size() == 2);
+        assert(realize(l_cover) == l_function);
+    }
+
+    /// Redundant terms must be dropped: ab + a'c + bc = ab + a'c.
+    {
+        const node* l_function =
+            disjoin(
+                conjoin(l_vars[0], l_vars[1]),
+                conjoin(invert(l_vars[0]), l_vars[2]),
+                conjoin(l_vars[1], l_vars[2])
+            );
+        std::vector<implicant> l_cover = minimize_64(l_function);
+        assert(l_cover.size() == 2);
+        assert(realize(l_cover) == l_function);
+    }
+
+    /// Majority of five needs all ten 3-literal terms.
+    {
+        const node* l_majority = ZERO;
+
+        for (uint32_t i = 0; i < 5; i++)
+            for (uint32_t j = i + 1; j < 5; j++)
+                for (uint32_t k = j + 1; k < 5; k++)
+                    l_majority = disjoin(l_majority, conjoin(l_vars[i], l_vars[j], l_vars[k]));
+
+        std::vector<implicant> l_cover = minimize_64(l_majority);
+        assert(l_cover.size() == 10);
+        assert(realize(l_cover) == l_majority);
+    }
+
+    /// Parity of six admits no merging at all.
+    {
+        const node* l_parity = exor(l_vars[0], l_vars[1], l_vars[2], l_vars[3], l_vars[4], l_vars[5]);
+        std::vector<implicant> l_cover = minimize_64(l_parity);
+        assert(l_cover.size() == 32);
+        assert(realize(l_cover) == l_parity);
+    }
+
+    /// Don't-cares are used to enlarge terms: ab with ab' free is a.
+    {
+        std::vector<implicant> l_cover =
+            minimize_64(
+                conjoin(l_vars[0], l_vars[1]),
+                conjoin(l_vars[0], invert(l_vars[1]))
+            );
+        assert(l_cover.size() == 1);
+        assert(realize(l_cover) == l_vars[0]);
+    }
+
+    /// Every cover of pseudo-random functions must contain
+    ///     the on-set and stay within the allowed set.
+    uint64_t l_state = 0x9E3779B97F4A7C15ULL;
+
+    const auto l_next = [&l_state]
+    {
+        l_state ^= l_state << 13;
+        l_state ^= l_state >> 7;
+        l_state ^= l_state << 17;
+        return l_state;
+    };
+
+    for (int i = 0; i < 32; i++)
+    {
+        const uint64_t l_on = l_next() & l_next();
+        const uint64_t l_dont_care = l_next() & l_next() & ~l_on;
+
+        uint64_t l_covered = 0;
+
+        for (const implicant& l_term : minimize_64(l_on, l_dont_care))
+        {
+            assert((l_term.mask() & ~(l_on | l_dont_care)) == 0);
+            l_covered |= l_term.mask();
+        }
+
+        assert((l_covered & l_on) == l_on);
+        
+    }
+
+}
+
+void test_batch_evaluator(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+    const node* l_d = literal(3, true);
+    const node* l_e = literal(4, true);
+    const node* l_f = literal(5, true);
+
+    const node* l_function =
+        conjoin(l_a, disjoin(l_b, l_c, l_d), invert(conjoin(l_e, l_f)));
+
+    batch_evaluator l_evaluator(l_function);
+
+    assert(l_evaluator.variables() == 6);
+
+    /// Bit i of the word for variable v is bit v of i,
+    ///     so one batch sweeps the whole input space.
+    std::vector<uint64_t> l_inputs(6);
+
+    for (uint32_t i = 0; i < 64; i++)
+        for (uint32_t v = 0; v < 6; v++)
+            if ((i >> v) & 1)
+                l_inputs[v] |= 1ULL << i;
+
+    const uint64_t l_outputs = l_evaluator.evaluate(l_inputs);
+
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        std::vector<bool> l_input(6);
+
+        for (uint32_t v = 0; v < 6; v++)
+            l_input[v] = (i >> v) & 1;
+
+        assert(evaluate(l_function, l_input) == (((l_outputs >> i) & 1) != 0));
+
+    }
+
+    /// A 4-lane batch over pseudo-random assignments.
+    const node* l_function_1 =
+        exnor(std::list{l_a, l_b, l_c}, std::list{l_d, l_e, l_f});
+
+    batch_evaluator l_evaluator_1(l_function_1);
+
+    uint64_t l_state = 0x2545F4914F6CDD1DULL;
+
+    std::vector<std::array<uint64_t, 4>> l_wide_inputs(6);
+
+    for (std::array<uint64_t, 4>& l_words : l_wide_inputs)
+        for (uint64_t& l_word : l_words)
+        {
+            l_state ^= l_state << 13;
+            l_state ^= l_state >> 7;
+            l_state ^= l_state << 17;
+            l_word = l_state;
+        }
+
+    const std::array<uint64_t, 4> l_wide_outputs = l_evaluator_1.evaluate<4>(l_wide_inputs);
+
+    for (uint32_t l = 0; l < 4; l++)
+        for (uint32_t i = 0; i < 64; i++)
+        {
+            std::vector<bool> l_input(6);
+
+            for (uint32_t v = 0; v < 6; v++)
+                l_input[v] = (l_wide_inputs[v][l] >> i) & 1;
+
+            assert(evaluate(l_function_1, l_input) == (((l_wide_outputs[l] >> i) & 1) != 0));
+
+        }
+
+    /// Terminal functions need no steps.
+    batch_evaluator l_one(ONE);
+    batch_evaluator l_zero(ZERO);
+
+    assert(l_one.size() == 0);
+    assert(l_one.evaluate(std::vector<uint64_t>{}) == ~0ULL);
+    assert(l_zero.evaluate(std::vector<uint64_t>{}) == 0);
+
+}
+
+void test_compiled_function(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+    const node* l_d = literal(3, true);
+    const node* l_e = literal(4, true);
+    const node* l_f = literal(5, true);
+
+    const node* l_function =
+        disjoin(conjoin(l_a, exor(l_b, l_c)), conjoin(l_d, invert(l_e), l_f));
+
+    compiled_function l_compiled(l_function);
+
+    /// The root is laid out first.
+    assert(l_compiled.root() == 0);
+    assert(l_compiled.records()[0].m_variable == 0);
+
+    for (uint64_t i = 0; i < 64; i++)
+    {
+        std::vector<bool> l_input(6);
+
+        for (uint32_t v = 0; v < 6; v++)
+            l_input[v] = (i >> v) & 1;
+
+        assert(l_compiled.evaluate(std::span(&i, 1)) == evaluate(l_function, l_input));
+
+    }
+
+    /// Variables beyond the first word.
+    const node* l_far = conjoin(l_a, literal(70, false));
+
+    compiled_function l_compiled_far(l_far);
+
+    assert(l_compiled_far.evaluate(std::vector<uint64_t>{ 1, 0 }) == true);
+    assert(l_compiled_far.evaluate(std::vector<uint64_t>{ 1, 1ULL << 6 }) == false);
+    assert(l_compiled_far.evaluate(std::vector<uint64_t>{ 0, 0 }) == false);
+
+    /// Constant functions compile to a bare terminal.
+    assert(compiled_function(ONE).records().empty());
+    assert(compiled_function(ONE).evaluate({}) == true);
+    assert(compiled_function(ZERO).evaluate({}) == false);
+
+}
+
+void test_generate_cpp(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    std::stringstream l_ss;
+
+    /// A multiplexer, forced into expression form.
+    generate_cpp(l_ss, disjoin(conjoin(l_a, l_b), conjoin(invert(l_a), l_c)), "mux", 0);
+
+    assert(l_ss.str() ==
+        "#include <stdint.h>\n"
+        "\n"
+        "bool mux(const uint64_t* x)\n"
+        "{\n"
+        "    return ((x[0] >> 0 & 1) ? (x[0] >> 1 & 1) : (x[0] >> 2 & 1));\n"
+        "}\n");
+
+    l_ss.str("");
+
+    /// Terminal children reduce to && and ||.
+    generate_cpp(l_ss, disjoin(l_a, conjoin(invert(l_b), literal(70, true))), "f", 0);
+
+    assert(l_ss.str() ==
+        "#include <stdint.h>\n"
+        "\n"
+        "bool f(const uint64_t* x)\n"
+        "{\n"
+        "    return ((x[0] >> 0 & 1) || (!(x[0] >> 1 & 1) && (x[1] >> 6 & 1)));\n"
+        "}\n");
+
+    l_ss.str("");
+
+    /// In a 4-input parity, [2] xor [3] and its inverse
+    ///     each have fan-in two, so become helpers.
+    generate_cpp(l_ss, exor(l_a, l_b, l_c, literal(3, true)), "g", 0);
+
+    assert(l_ss.str() ==
+        "#include <stdint.h>\n"
+        "\n"
+        "static inline bool g_0(const uint64_t* x)\n"
+        "{\n"
+        "    return ((x[0] >> 2 & 1) ? !(x[0] >> 3 & 1) : (x[0] >> 3 & 1));\n"
+        "}\n"
+        "\n"
+        "static inline bool g_1(const uint64_t* x)\n"
+        "{\n"
+        "    return ((x[0] >> 2 & 1) ? (x[0] >> 3 & 1) : !(x[0] >> 3 & 1));\n"
+        "}\n"
+        "\n"
+        "bool g(const uint64_t* x)\n"
+        "{\n"
+        "    return ((x[0] >> 0 & 1) ? ((x[0] >> 1 & 1) ? g_0(x) : g_1(x)) : ((x[0] >> 1 & 1) ? g_1(x) : g_0(x)));\n"
+        "}\n");
+
+    l_ss.str("");
+
+    /// Small supports become a table. Verify it exhaustively
+    ///     against evaluate, its index being the support
+    ///     variables in ascending order.
+    const node* l_function = exor(l_a, conjoin(l_c, literal(9, false)));
+
+    generate_cpp(l_ss, l_function, "t");
+
+    const std::string l_code = l_ss.str();
+    const size_t l_table_begin = l_code.find("0x") + 2;
+    const uint64_t l_table = std::stoull(l_code.substr(l_table_begin), nullptr, 16);
+
+    assert(l_code.find("(x[0] >> 0 & 1) << 0 | (x[0] >> 2 & 1) << 1 | (x[0] >> 9 & 1) << 2;") != std::string::npos);
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        std::vector<bool> l_input(10);
+
+        l_input[0] = i & 1;
+        l_input[2] = (i >> 1) & 1;
+        l_input[9] = (i >> 2) & 1;
+
+        assert(evaluate(l_function, l_input) == (((l_table >> i) & 1) != 0));
+
+    }
+
+    /// A table support past six still gives expressions
+    ///     for functions of seven variables.
+    l_ss.str("");
+
+    generate_cpp(l_ss, exor(l_a, l_b, l_c, literal(3, true), literal(4, true), literal(5, true), literal(6, true)), "wide", 10);
+
+    assert(l_ss.str().find("TABLE") == std::string::npos);
+
+}
+
+void test_incremental_evaluator(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::list<const node*> l_x;
+    std::list<const node*> l_y;
 
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        l_x.push_back(literal(i, true));
+        l_y.push_back(literal(5 + i, true));
+    }
+
+    const node* l_function = *std::next(multiply(l_x, l_y).begin(), 4);
+
+    /// Arbitrary jumps between inputs.
+    {
+        incremental_evaluator l_evaluator(l_function, std::vector<uint64_t>{ 0 });
+
+        uint64_t l_state = 0x853C49E6748FEA9BULL;
+
+        for (int i = 0; i < 256; i++)
+        {
+            l_state ^= l_state << 13;
+            l_state ^= l_state >> 7;
+            l_state ^= l_state << 17;
+
+            uint64_t l_input = l_state & 0x3FF;
+
+            assert(l_evaluator.evaluate(std::span(&l_input, 1)) == evaluate(l_function, std::span(&l_input, 1)));
+            assert(l_evaluator.input()[0] == l_input);
+
+        }
+    }
+
+    /// Flipping a variable off the path does no work.
+    {
+        const node* l_conjunction = conjoin(literal(0, true), literal(1, true));
+
+        incremental_evaluator l_evaluator(l_conjunction, std::vector<uint64_t>{ 0 });
+
+        assert(l_evaluator.result() == false);
+        assert(l_evaluator.steps() == 1);
+
+        l_evaluator.flip(1);
+
+        assert(l_evaluator.result() == false);
+        assert(l_evaluator.steps() == 1);
+
+        assert(l_evaluator.flip(0) == true);
+        assert(l_evaluator.steps() == 3);
+
+        assert(l_evaluator.evaluate(std::vector<uint64_t>{ 3 }) == true);
+        assert(l_evaluator.steps() == 3);
+
+    }
+
+    /// An exhaustive Gray code sweep matches evaluate,
+    ///     at amortized constant cost.
+    {
+        incremental_evaluator l_evaluator(l_function, std::vector<uint64_t>{ 0 });
+
+        size_t l_visited = 0;
+
+        l_evaluator.sweep(
+            10,
+            [&](std::span<const uint64_t> a_input, bool a_result)
+            {
+                assert(a_result == evaluate(l_function, a_input));
+                l_visited++;
+            }
+        );
+
+        assert(l_visited == 1024);
+        assert(l_evaluator.steps() <= 2 * 1024 + 10);
+
+    }
+
+}
+
+void test_expand(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    /// Tables narrower than a word occupy its low bits.
+    assert(expand(l_a, 1) == std::vector<uint64_t>{ 0x2 });
+    assert(expand(conjoin(l_a, invert(l_c)), 3) == std::vector<uint64_t>{ 0x50 });
+    assert(expand(ONE, 2) == std::vector<uint64_t>{ 0xF });
+    assert(expand(ZERO, 8) == std::vector<uint64_t>(4, 0));
+
+    /// Six variables agree with truth_table_64.
+    const node* l_function_0 =
+        disjoin(conjoin(l_a, exor(l_b, l_c)), conjoin(literal(3, true), literal(5, false)));
+
+    assert(expand(l_function_0, 6) == std::vector<uint64_t>{ truth_table_64(l_function_0) });
+
+    /// Larger tables, with skipped depths and several threads,
+    ///     agree with evaluate on every minterm.
+    std::list<const node*> l_x;
+    std::list<const node*> l_y;
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        l_x.push_back(literal(2 * i, true));
+        l_y.push_back(literal(2 * i + 1, true));
+    }
+
+    const node* l_function_1 =
+        conjoin(*std::next(multiply(l_x, l_y).begin(), 6), literal(15, false));
+
+    constexpr uint32_t VARIABLES = 16;
+
+    for (uint32_t l_threads : { 1, 4 })
+    {
+        const std::vector<uint64_t> l_table = expand(l_function_1, VARIABLES, l_threads);
+
+        assert(l_table.size() == truth_table_words(VARIABLES));
+
+        for (uint32_t i = 0; i < (1U << VARIABLES); i++)
+        {
+            std::bitset<VARIABLES> l_input;
+
+            for (uint32_t v = 0; v < VARIABLES; v++)
+                l_input[v] = (i >> (VARIABLES - 1 - v)) & 1;
+
+            assert(evaluate(l_function_1, l_input) == (((l_table[i / 64] >> (i % 64)) & 1) != 0));
+
+        }
+    }
+
+}
+
+void test_from_truth_table(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    /// Variable 0 is the most significant minterm bit,
+    ///     so [0][1]' is minterm 2 alone.
+    assert(from_truth_table(truth_table_from_hex("4", 2), 2) == conjoin(l_a, invert(l_b)));
+    assert(from_truth_table(truth_table_from_hex("0xE8", 3), 3) == disjoin(conjoin(l_a, l_b), conjoin(l_a, l_c), conjoin(l_b, l_c)));
+    assert(from_truth_table(truth_table_from_hex("1", 1), 1) == invert(l_a));
+    assert(from_truth_table(truth_table_from_hex("ffff", 4), 4) == ONE);
+    assert(from_truth_table(truth_table_from_hex("00000000000000000000000000000000", 7), 7) == ZERO);
+
+    bool l_thrown = false;
+
+    try
+    {
+        truth_table_from_hex("E8g", 3);
+    }
+    catch (const std::invalid_argument&)
+    {
+        l_thrown = true;
+    }
+
+    assert(l_thrown);
+
+    /// Round trips through expand, which yield the very same
+    ///     node since both functions live in one dag.
+    std::list<const node*> l_x;
+    std::list<const node*> l_y;
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        l_x.push_back(literal(2 * i, true));
+        l_y.push_back(literal(2 * i + 1, true));
+    }
+
+    const node* l_function_0 =
+        conjoin(*std::next(multiply(l_x, l_y).begin(), 6), literal(15, false));
+
+    assert(from_truth_table(expand(l_function_0, 16), 16) == l_function_0);
+
+    const node* l_function_1 = conjoin(l_c, literal(5, false));
+
+    assert(from_truth_table(expand(l_function_1, 6), 6) == l_function_1);
+    assert(from_truth_table(expand(l_function_1, 9), 9) == l_function_1);
+
+    /// The threaded builder agrees with the sequential one.
+    const node* l_function_2 = exor(l_function_0, literal(20, true), literal(23, true));
+
+    const std::vector<uint64_t> l_table = expand(l_function_2, 24);
+
+    assert(from_truth_table(l_table, 24, 1) == l_function_2);
+    assert(from_truth_table(l_table, 24, 4) == l_function_2);
+
+    /// Too many variables, or a table of the wrong size,
+    ///     is refused by each entry point.
+    const std::vector<uint64_t> l_short(2);
+
+    for (const auto& l_call : std::initializer_list<std::function<void()>>{
+        [&] { expand(l_function_0, TRUTH_TABLE_MAX_VARIABLES + 1); },
+        [&] { truth_table_from_hex("0", TRUTH_TABLE_MAX_VARIABLES + 1); },
+        [&] { from_truth_table(l_short, TRUTH_TABLE_MAX_VARIABLES + 1); },
+        [&] { from_truth_table(l_short, 9); },
+    })
+    {
+        l_thrown = false;
+
+        try
+        {
+            l_call();
+        }
+        catch (const std::invalid_argument&)
+        {
+            l_thrown = true;
+        }
+
+        assert(l_thrown);
+    }
+
+}
+
+void test_from_cubes(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+    const node* l_d = literal(3, true);
+
+    assert(from_cubes({}) == ZERO);
+    assert(from_cubes({ "----" }) == ONE);
+    assert(from_cubes({ "1---" }) == l_a);
+    assert(from_cubes({ "--0-" }) == invert(l_c));
+    assert(from_cubes({ "10-1" }) == conjoin(l_a, invert(l_b), l_d));
+
+    /// Overlapping, duplicated and absorbed cubes.
+    assert(from_cubes({ "11--", "0-1-", "-11-", "11--" }) == disjoin(conjoin(l_a, l_b), conjoin(invert(l_a), l_c)));
+    assert(from_cubes({ "---1", "1--1", "-0--" }) == disjoin(l_d, invert(l_b)));
+
+    /// A minterm list, and the same function as a cover.
+    assert(from_cubes({ "000", "011", "101", "110" }) == invert(exor(l_a, l_b, l_c)));
+    assert(from_cubes({ "0-1", "-01", "1-0", "-10", "111" }) == disjoin(exor(l_a, l_c), exor(l_b, l_c), conjoin(l_a, l_b, l_c)));
+
+    /// Against disjoining literal products one at a time.
+    std::mt19937_64 l_random(7);
+
+    for (int l_trial = 0; l_trial < 16; l_trial++)
+    {
+        std::vector<std::string> l_storage;
+        const node* l_expected = ZERO;
+
+        for (int i = 0; i < 24; i++)
+        {
+            std::string l_cube;
+            const node* l_product = ONE;
+
+            for (uint32_t v = 0; v < 8; v++)
+            {
+                const char l_char = "01--"[l_random() % 4];
+
+                l_cube.push_back(l_char);
+
+                if (l_char != '-')
+                    l_product = conjoin(l_product, literal(v, l_char == '1'));
+            }
+
+            l_storage.push_back(l_cube);
+            l_expected = disjoin(l_expected, l_product);
+
+        }
+
+        assert(from_cubes(std::vector<std::string_view>(l_storage.begin(), l_storage.end())) == l_expected);
+
+    }
+
+    bool l_thrown = false;
+
+    try
+    {
+        from_cubes({ "01", "0x" });
+    }
+    catch (const std::invalid_argument&)
+    {
+        l_thrown = true;
+    }
+
+    assert(l_thrown);
+
+}
+
+void test_parse(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    ast l_ast;
+
+    const auto l_parse = [&](std::string_view a_text)
+    {
+        const std::optional<parse_error> l_error = parse(a_text, l_ast);
+        assert(!l_error);
+        return build(l_ast);
+    };
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    /// Precedence: inversion, then conjunction, then disjunction.
+    assert(l_parse("[0][1]+[2]") == disjoin(conjoin(l_a, l_b), l_c));
+    assert(l_parse("[0]([1]+[2])") == conjoin(l_a, disjoin(l_b, l_c)));
+    assert(l_parse("([0]+[1])'[2]") == conjoin(invert(disjoin(l_a, l_b)), l_c));
+    assert(l_parse("[0][1]'") == conjoin(l_a, invert(l_b)));
+    assert(l_parse("[0]''") == l_a);
+    assert(l_parse(" [0] [1] + [2]\n") == disjoin(conjoin(l_a, l_b), l_c));
+
+    /// Contradictions and tautologies fold away.
+    assert(l_parse("[0][0]'[1]") == ZERO);
+    assert(l_parse("[0]+[0]'") == ONE);
+    assert(l_parse("()") == ONE);
+    assert(l_parse("") == ONE);
+
+    /// Whatever operator<< prints parses back to the same node,
+    ///     as operator>> does.
+    {
+        const node* l_function = l_parse("[0]'[1][3]+[1]'([2]+[4]')+[0][2][3]'[4]+([1]+[3])'");
+
+        std::stringstream l_ss;
+
+        l_ss << l_function;
+
+        assert(l_parse(l_ss.str()) == l_function);
+
+        const node* l_extracted;
+
+        l_ss >> l_extracted;
+
+        assert(l_extracted == l_function);
+    }
+
+    /// Repeated subexpressions share one vertex.
+    {
+        assert(!parse("([2][3])'+[0]([2][3])'+[1]([3][2])'", l_ast));
+
+        const ast::vertex& l_root = l_ast.m_vertices[l_ast.m_root];
+        const ast::vertex& l_second = l_ast.m_vertices[l_ast.m_operands[l_root.m_first + 1]];
+        const ast::vertex& l_third = l_ast.m_vertices[l_ast.m_operands[l_root.m_first + 2]];
+
+        const uint32_t l_repeated = l_ast.m_operands[l_root.m_first];
+
+        assert(l_ast.m_operands[l_second.m_first + 1] == l_repeated);
+        assert(l_ast.m_operands[l_third.m_first + 1] != l_repeated);
+
+        /// [0..3], [2][3], [3][2], two inversions, two
+        ///     products and the sum.
+        assert(l_ast.m_vertices.size() == 11);
+
+        assert(build(l_ast) == invert(conjoin(l_c, literal(3, true))));
+    }
+
+    /// Long sums are flat rather than nested.
+    {
+        std::string l_text;
+
+        for (uint32_t i = 0; i < 100000; i++)
+            l_text += "[" + std::to_string(i % 64) + "]" + (i % 3 == 0 ? "'" : "") + "+";
+
+        l_text += "[64]";
+
+        assert(!parse(l_text, l_ast));
+        assert(l_ast.m_vertices[l_ast.m_root].m_kind == ast::vertex::SUM);
+        assert(l_ast.m_vertices[l_ast.m_root].m_count == 100001);
+    }
+
+    /// Errors carry the offending position.
+    const auto l_error = [&](std::string_view a_text, size_t a_position)
+    {
+        const std::optional<parse_error> l_result = parse(a_text, l_ast);
+        return l_result && l_result->m_position == a_position;
+    };
+
+    assert(l_error("[0", 0));
+    assert(l_error("[0][x]", 3));
+    assert(l_error("[0]+*", 4));
+    assert(l_error("[1]([0]", 3));
+    assert(l_error("[0]+[1])", 7));
+    assert(l_error("'", 0));
+    assert(l_error("[0]+'[1]", 4));
+    assert(l_error("[99999999999]", 0));
+
+}
+
+void test_load_expression(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const std::string l_path = (std::filesystem::temp_directory_path() / "factor_test_load_expression.txt").string();
+
+    const auto l_load = [&](std::string_view a_text, size_t a_chunk_bytes)
+    {
+        std::ofstream(l_path, std::ios::binary) << a_text;
+
+        const node* l_node = nullptr;
+
+        const std::optional<parse_error> l_error = load_expression(l_path.c_str(), l_node, a_chunk_bytes);
+
+        return std::make_pair(l_error, l_node);
+    };
+
+    ast l_ast;
+
+    const auto l_parse = [&](std::string_view a_text)
+    {
+        assert(!parse(a_text, l_ast));
+        return build(l_ast);
+    };
+
+    /// Agrees with the in-memory parser.
+    for (std::string_view l_text : {
+        "[0][1]+[2]",
+        "([0]+[1])'[2]''",
+        "[3]'([0]+([1][2])')+[1][0]'",
+        "[0][0]'+[1]",
+        "()",
+        "",
+        " [0] +\n[1]' ",
+    })
+    {
+        const auto [l_error, l_node] = l_load(l_text, LOAD_CHUNK_BYTES);
+        assert(!l_error);
+        assert(l_node == l_parse(l_text));
+    }
+
+    /// Text spanning many windows, with variables cut
+    ///     across their boundaries, loads the same.
+    {
+        std::string l_text;
+
+        for (uint32_t i = 0; i < 4000; i++)
+        {
+            l_text += i > 0 ? "+(" : "(";
+
+            for (uint32_t k = 0; k < 4; k++)
+                l_text += "[" + std::to_string(4 * i + k) + "]" + ((i + k) % 3 ? "'" : "");
+
+            l_text += ")";
+        }
+
+        const auto [l_error, l_node] = l_load(l_text, 1);
+        assert(!l_error);
+        assert(l_node == l_parse(l_text));
+    }
+
+    /// A new name takes no index the file writes as "[i]",
+    ///     even one written after it in a later window.
+    {
+        const auto [l_error, l_node] = l_load("x [0]' + [1]", 1);
+        assert(!l_error);
+        assert(l_nodes.symbols().find("x") == 2);
+        assert(l_node == disjoin(conjoin(literal(2, true), literal(0, false)), literal(1, true)));
+    }
+
+    /// Names, with and without bit indices, likewise.
+    {
+        std::string l_text;
+
+        for (uint32_t i = 0; i < 4000; i++)
+            l_text += (i > 0 ? "+" : "") + std::string("signal_") + std::to_string(i) + " bus[" + std::to_string(i) + "]'";
+
+        const auto [l_error, l_node] = l_load(l_text, 1);
+        assert(!l_error);
+        assert(l_node == l_parse(l_text));
+    }
+
+    /// Errors carry their offset in the file.
+    const auto l_error = [&](std::string_view a_text, size_t a_position)
+    {
+        const std::optional<parse_error> l_result = l_load(a_text, LOAD_CHUNK_BYTES).first;
+        return l_result && l_result->m_position == a_position;
+    };
+
+    assert(l_error("[0", 0));
+    assert(l_error("[1]([0]", 3));
+    assert(l_error("[0]+[1])", 7));
+    assert(l_error("[0]+'[1]", 4));
+    assert(l_error("[0]+*", 4));
+
+    std::filesystem::remove(l_path);
+
+    bool l_thrown = false;
+
+    try
+    {
+        const node* l_node;
+        load_expression(l_path.c_str(), l_node);
+    }
+    catch (const std::system_error&)
+    {
+        l_thrown = true;
+    }
+
+    assert(l_thrown);
+
+}
+
+void test_parse_lines(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// Lines sharing subexpressions, with a few malformed.
+    std::string l_text;
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        if (i % 97 == 13)
+            l_text += "[" + std::to_string(i % 16) + "]+(";
+        else
+            l_text += "[" + std::to_string(i % 16) + "]'([" + std::to_string(16 + i % 7) + "]+[20][21]')+[3]";
+
+        l_text += "\n";
+    }
+
+    ast l_ast;
+
+    for (uint32_t l_threads : { 1, 4 })
+    {
+        std::vector<line_error> l_errors;
+
+        const std::vector<const node*> l_roots = parse_lines(l_text, l_errors, l_threads);
+
+        assert(l_roots.size() == 1000);
+        assert(l_errors.size() == 11);
+
+        for (size_t i = 0; i < l_errors.size(); i++)
+        {
+            assert(l_errors[i].m_line == 97 * i + 13);
+            assert(l_errors[i].m_error.m_position == (l_errors[i].m_line % 16 < 10 ? 4 : 5));
+        }
+
+        /// Roots land in the bound dag, in input order.
+        size_t l_line = 0;
+
+        for (size_t l_begin = 0; l_begin < l_text.size(); l_line++)
+        {
+            const size_t l_end = l_text.find('\n', l_begin);
+            const std::string_view l_expression(l_text.data() + l_begin, l_end - l_begin);
+
+            if (parse(l_expression, l_ast))
+                assert(l_roots[l_line] == ZERO);
+            else
+                assert(l_roots[l_line] == build(l_ast));
+
+            l_begin = l_end + 1;
+        }
+    }
+
+    /// New names first appearing in different blocks receive
+    ///     the same indices whatever the number of threads.
+    {
+        std::string l_named;
+
+        for (uint32_t i = 0; i < 256; i++)
+            l_named += "s" + std::to_string(i / 32) + " [" + std::to_string(i % 8) + "]' + t" + std::to_string((255 - i) / 48) + "\n";
+
+        std::vector<std::string> l_expected;
+
+        for (uint32_t l_threads : { 1, 4 })
+        {
+            dag l_fresh;
+
+            global_node_sink::bind(&l_fresh);
+
+            std::vector<line_error> l_errors;
+
+            const std::vector<const node*> l_roots = parse_lines(l_named, l_errors, l_threads);
+
+            assert(l_errors.empty());
+
+            std::vector<std::string> l_printed;
+
+            for (const node* l_root : l_roots)
+            {
+                std::stringstream l_stream;
+
+                l_stream << l_root << " = ";
+
+                print(l_stream, l_root, l_fresh.symbols());
+
+                l_printed.push_back(l_stream.str());
+            }
+
+            if (l_expected.empty())
+                l_expected = l_printed;
+            else
+                assert(l_printed == l_expected);
+        }
+
+        global_node_sink::bind(&l_nodes);
+    }
+
+    /// The bound dag is left as it was.
+    assert(global_node_sink::bound() == &l_nodes);
+
+    std::vector<line_error> l_errors;
+
+    assert(parse_lines("", l_errors).empty());
+    assert(parse_lines("[0]\n\n", l_errors).size() == 2);
+    assert(l_errors.empty());
+
+}
+
+void test_symbol_table(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    symbol_table& l_symbols = l_nodes.symbols();
+
+    /// Names receive the lowest free index, skipping
+    ///     those preassigned.
+    const std::string_view l_order[] = { "clk", "rst" };
+
+    l_symbols.assign(l_order);
+    l_symbols.assign("req_valid", 3);
+
+    assert(l_symbols.intern("a") == 2);
+    assert(l_symbols.intern("b") == 4);
+    assert(l_symbols.intern("rst") == 1);
+    assert(l_symbols.intern("a") == 2);
+    assert(l_symbols.size() == 5);
+
+    assert(l_symbols.find("req_valid") == 3);
+    assert(!l_symbols.find("c"));
+    assert(l_symbols.name(0) == "clk");
+    assert(l_symbols.name(7).empty());
+
+    /// Conflicting assignments are refused.
+    for (const auto& [l_name, l_variable_index] : { std::make_pair("a", 9U), std::make_pair("c", 0U) })
+    {
+        bool l_thrown = false;
+
+        try
+        {
+            l_symbols.assign(l_name, l_variable_index);
+        }
+        catch (const std::invalid_argument&)
+        {
+            l_thrown = true;
+        }
+
+        assert(l_thrown);
+    }
+
+    /// Names parse as variables, and bit indices attach.
+    ast l_ast;
+
+    const auto l_parse = [&](std::string_view a_text)
+    {
+        assert(!parse(a_text, l_ast));
+        return build(l_ast);
+    };
+
+    assert(l_parse("a b' + req_valid") == disjoin(conjoin(literal(2, true), literal(4, false)), literal(3, true)));
+    assert(l_parse("a[0]'") == literal(l_symbols.intern("a[0]"), false));
+    assert(l_parse("a [0]") == conjoin(literal(2, true), literal(0, true)));
+    assert(parse("a[x]", l_ast)->m_position == 0);
+    assert(parse("a+9", l_ast)->m_position == 2);
+
+    /// A name already bound is its index, but a new name never
+    ///     takes an index the expression writes as "[i]".
+    assert(l_parse("(clk+rst)[2]") == l_parse("([0]+[1])a"));
+
+    {
+        dag l_fresh;
+
+        global_node_sink::bind(&l_fresh);
+
+        assert(l_parse("x [0]'") == conjoin(literal(1, true), literal(0, false)));
+        assert(l_parse("[0] + y") == disjoin(literal(0, true), literal(2, true)));
+        assert(l_parse("z' + [0][1][2]' [3]") == disjoin(literal(4, false), conjoin(conjoin(literal(0, true), literal(1, true)), conjoin(literal(2, false), literal(3, true)))));
+        assert(l_fresh.symbols().find("x") == 1);
+        assert(l_fresh.symbols().find("y") == 2);
+        assert(l_fresh.symbols().find("z") == 4);
+
+        global_node_sink::bind(&l_nodes);
+    }
+
+    /// Printing by name reads back the same.
+    {
+        const node* l_function = l_parse("a b'[5] + bus[3](clk + rst' a[0]) + [6] b");
+
+        std::stringstream l_named;
+
+        print(l_named, l_function, l_symbols);
+
+        assert(l_parse(l_named.str()) == l_function);
+
+        /// Plain printing is unaffected by the names.
+        std::stringstream l_plain;
+        std::stringstream l_indexed;
+
+        l_plain << l_function;
+
+        print(l_indexed, l_function, symbol_table());
+
+        assert(l_plain.str() == l_indexed.str());
+        assert(l_plain.str().find_first_of("abcr") == std::string::npos);
+    }
+
+    /// Threads share one table.
+    {
+        std::string l_text;
+
+        for (uint32_t i = 0; i < 512; i++)
+            l_text += "n" + std::to_string(i % 37) + " m" + std::to_string(i % 11) + "'\n";
+
+        std::vector<line_error> l_errors;
+
+        const std::vector<const node*> l_roots = parse_lines(l_text, l_errors, 4);
+
+        for (uint32_t i = 0; i < 512; i++)
+            assert(l_roots[i] == l_parse("n" + std::to_string(i % 37) + " m" + std::to_string(i % 11) + "'"));
+    }
+
+}
+
+void test_pla(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// Minterms in neither the on-set nor the off-set of
+    ///     an fr PLA are don't-cares.
+    {
+        std::stringstream l_text(
+            "# a comment\n"
+            ".i 3\n"
+            ".o 2\n"
+            ".ilb a b c\n"
+            ".ob f g\n"
+            ".type fr\n"
+            ".p 3\n"
+            "1-1 1~\n"
+            "0 0 2  | 01\n"
+            "110 ~0\n"
+            ".e\n"
+            "this is never read\n"
+        );
+
+        pla l_pla;
+
+        assert(!read_pla(l_text, l_pla));
+
+        assert(l_pla.m_inputs == 3);
+        assert((l_pla.m_input_labels == std::vector<std::string>{ "a", "b", "c" }));
+        assert((l_pla.m_output_labels == std::vector<std::string>{ "f", "g" }));
+
+        const std::pair<uint32_t, bool> l_a_c[] = { { 0, true }, { 2, true } };
+        const std::pair<uint32_t, bool> l_a_b[] = { { 0, false }, { 1, false } };
+        const std::pair<uint32_t, bool> l_a_b_c[] = { { 0, true }, { 1, true }, { 2, false } };
+
+        assert(l_pla.m_on[0] == cube(l_a_c));
+        assert(l_pla.m_dont_care[0] == invert(disjoin(cube(l_a_c), cube(l_a_b))));
+        assert(l_pla.m_on[1] == cube(l_a_b));
+        assert(l_pla.m_dont_care[1] == invert(disjoin(cube(l_a_b), cube(l_a_b_c))));
+    }
+
+    /// Covers written stay within each output's don't-cares,
+    ///     and read back the same however the text is split.
+    std::mt19937_64 l_random(0);
+
+    for (uint32_t l_inputs : { 5, 10 })
+    {
+        std::string l_text = ".i " + std::to_string(l_inputs) + "\n.o 3\n";
+
+        for (uint32_t i = 0; i < 40; i++)
+        {
+            for (uint32_t v = 0; v < l_inputs; v++)
+                l_text += "01--"[l_random() % 4];
+
+            l_text += " ";
+
+            for (uint32_t k = 0; k < 3; k++)
+                l_text += "0011-"[l_random() % 5];
+
+            l_text += "\n";
+        }
+
+        pla l_pla;
+
+        for (size_t l_buffer_bytes : { size_t(1), size_t(7), PLA_BUFFER_BYTES })
+        {
+            std::stringstream l_stream(l_text);
+
+            pla l_split;
+
+            assert(!read_pla(l_stream, l_split, l_buffer_bytes));
+
+            if (l_buffer_bytes != 1)
+                assert(l_split.m_on == l_pla.m_on && l_split.m_dont_care == l_pla.m_dont_care);
+
+            l_pla = l_split;
+        }
+
+        std::stringstream l_written;
+
+        write_pla(l_written, l_pla);
+
+        pla l_covers;
+
+        assert(!read_pla(l_written, l_covers));
+
+        assert(l_covers.m_inputs == l_inputs);
+
+        for (size_t k = 0; k < 3; k++)
+        {
+            assert(l_covers.m_dont_care[k] == ZERO);
+            assert(conjoin(l_pla.m_on[k], invert(l_covers.m_on[k])) == ZERO);
+            assert(conjoin(l_covers.m_on[k], invert(disjoin(l_pla.m_on[k], l_pla.m_dont_care[k]))) == ZERO);
+        }
+    }
+
+    /// Malformed text reports its line and position.
+    for (const auto& [l_text, l_line, l_position] : std::initializer_list<std::tuple<const char*, size_t, size_t>>{
+        { ".i 2\n.o 1\n01 1\n0 1\n", 3, 3 },
+        { ".i 2\n.o 1\n01 1\n0x 1\n", 3, 1 },
+        { ".i 2\n.o 1\n011 1\n", 2, 4 },
+        { ".i two\n", 0, 3 },
+        { "01 1\n", 0, 0 },
+        { ".i 2\n.o 1\n.type fx\n", 2, 6 },
+        { ".i 2\n.ilb a\n", 1, 6 },
+        { ".i 2\n", 1, 0 },
+    })
+    {
+        std::stringstream l_stream(l_text);
+
+        pla l_pla;
+
+        const std::optional<line_error> l_error = read_pla(l_stream, l_pla);
+
+        assert(l_error && l_error->m_line == l_line && l_error->m_error.m_position == l_position);
+    }
+
+}
+
+void test_cnf(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// Clauses may span lines, and '%' ends the formula.
+    {
+        std::stringstream l_text(
+            "c an example\n"
+            "p cnf 3 3\n"
+            "1 -2 0\n"
+            "  2 3\n"
+            "0 -1 -3 0\n"
+            "%\n"
+            "0\n"
+        );
+
+        cnf l_cnf;
+
+        assert(!read_dimacs(l_text, l_cnf, 5));
+
+        assert(l_cnf.m_variables == 3);
+        assert(l_cnf.m_clauses.size() == 3);
+
+        const node* l_expected = conjoin(
+            conjoin(disjoin(literal(0, true), literal(1, false)), disjoin(literal(1, true), literal(2, true))),
+            disjoin(literal(0, false), literal(2, false))
+        );
+
+        for (conjunction_schedule l_schedule : { FILE_ORDER, BUCKETS })
+        {
+            conjunction_statistics l_statistics;
+
+            assert(conjoin_clauses(l_cnf, l_statistics, l_schedule) == l_expected);
+            assert(l_statistics.m_conjunctions > 0);
+            assert(l_statistics.m_dag_nodes == l_nodes.size());
+        }
+    }
+
+    /// The last clause may omit its 0, and a
+    ///     contradiction is ZERO.
+    {
+        std::stringstream l_text("p cnf 1 2\n1 0\n-1");
+
+        cnf l_cnf;
+
+        assert(!read_dimacs(l_text, l_cnf));
+
+        conjunction_statistics l_statistics;
+
+        assert(conjoin_clauses(l_cnf, l_statistics, FILE_ORDER) == ZERO);
+        assert(conjoin_clauses(l_cnf, l_statistics, BUCKETS) == ZERO);
+    }
+
+    /// Schedules agree on random formulas over short
+    ///     windows of the order, given in random order.
+    std::mt19937_64 l_random(0);
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        cnf l_cnf{ 40 };
+
+        for (uint32_t l_clause = 0; l_clause < 60; l_clause++)
+        {
+            const uint32_t l_window = l_random() % 35;
+
+            auto& l_literals = l_cnf.m_clauses.emplace_back();
+
+            for (uint32_t k = 0; k < 3; k++)
+                l_literals.emplace_back(l_window + l_random() % 6, l_random() % 2);
+        }
+
+        conjunction_statistics l_file_order;
+        conjunction_statistics l_buckets;
+
+        assert(conjoin_clauses(l_cnf, l_file_order, FILE_ORDER) == conjoin_clauses(l_cnf, l_buckets, BUCKETS));
+    }
+
+    /// Malformed text reports its line and position.
+    for (const auto& [l_text, l_line, l_position] : std::initializer_list<std::tuple<const char*, size_t, size_t>>{
+        { "1 0\n", 0, 0 },
+        { "p cnf 2 1\n1 3 0\n", 1, 2 },
+        { "p cnf 2 1\n1 x 0\n", 1, 2 },
+        { "p dnf 2 1\n", 0, 2 },
+        { "p cnf 2\n", 0, 7 },
+        { "p cnf 2 1\np cnf 2 1\n", 1, 0 },
+        { "c only a comment\n", 1, 0 },
+    })
+    {
+        std::stringstream l_stream(l_text);
+
+        cnf l_cnf;
+
+        const std::optional<line_error> l_error = read_dimacs(l_stream, l_cnf);
+
+        assert(l_error && l_error->m_line == l_line && l_error->m_error.m_position == l_position);
+    }
+
+    /// An overstated clause count reserves no more than the bound.
+    {
+        std::stringstream l_stream("p cnf 3 4000000000\n1 -2 0\n3 0\n");
+
+        cnf l_cnf;
+
+        assert(!read_dimacs(l_stream, l_cnf));
+        assert(l_cnf.m_clauses.size() == 2);
+        assert(l_cnf.m_clauses.capacity() <= CNF_RESERVED_CLAUSES);
+    }
+
+    /// An overstated variable count costs nothing either.
+    {
+        std::stringstream l_stream("p cnf 4000000000 1\n1 -2 0\n");
+
+        cnf l_cnf;
+
+        assert(!read_dimacs(l_stream, l_cnf));
+
+        conjunction_statistics l_statistics;
+
+        assert(conjoin_clauses(l_cnf, l_statistics, BUCKETS) == disjoin(literal(0, true), literal(1, false)));
+    }
+
+}
+
+/// Evaluates every signal of the netlist on the argued input,
+///     in which variable v is bit v, returning each output.
+std::vector<bool> simulate(
+    const netlist& a_netlist,
+    uint64_t a_input
+)
+{
+    const uint32_t l_first_gate = a_netlist.m_inputs.size() + 1;
+
+    std::vector<bool> l_values(l_first_gate + a_netlist.m_gates.size());
+
+    for (uint32_t i = 0; i < a_netlist.m_inputs.size(); i++)
+        l_values[1 + i] = (a_input >> i) & 1;
+
+    const auto l_literal_value = [&](uint32_t a_literal) { return l_values[a_literal / 2] != bool(a_literal % 2); };
+
+    for (uint32_t l_gate_index : a_netlist.m_order)
+    {
+        const netlist::gate& l_gate = a_netlist.m_gates[l_gate_index];
+
+        bool l_covered = false;
+
+        for (uint32_t l_row = 0; l_row < l_gate.m_row_count && !l_covered; l_row++)
+        {
+            l_covered = true;
+
+            for (uint32_t i = 0; i < l_gate.m_fanin_count; i++)
+            {
+                const char l_char = a_netlist.m_rows[l_gate.m_first_row + l_row * l_gate.m_fanin_count + i];
+
+                if (l_char != '-' && l_literal_value(a_netlist.m_fanins[l_gate.m_first_fanin + i]) != (l_char == '1'))
+                    l_covered = false;
+            }
+        }
+
+        l_values[l_first_gate + l_gate_index] = l_covered != l_gate.m_off_set;
+
+    }
+
+    std::vector<bool> l_outputs;
+
+    for (uint32_t l_output : a_netlist.m_outputs)
+        l_outputs.push_back(l_literal_value(l_output));
+
+    return l_outputs;
+
+}
+
+void test_netlist(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    /// A full adder, its gates out of order, with an
+    ///     off-set cover and a constant.
+    {
+        std::stringstream l_text(
+            "# a full adder\n"
+            ".model adder\n"
+            ".inputs a b \\\n"
+            "    cin\n"
+            ".outputs sum cout nand zero\n"
+            ".names t cin sum\n"
+            "10 1\n"
+            "01 1\n"
+            ".names a b t  # a xor b\n"
+            "01 1\n"
+            "10 1\n"
+            ".names a b cin cout\n"
+            "11- 1\n"
+            "1-1 1\n"
+            "-11 1\n"
+            ".names a b nand\n"
+            "11 0\n"
+            ".names zero\n"
+            ".end\n"
+        );
+
+        netlist l_netlist;
+
+        assert(!read_blif(l_text, l_netlist));
+
+        assert((l_netlist.m_inputs == std::vector<std::string>{ "a", "b", "cin" }));
+        assert(l_netlist.m_output_names.size() == 4);
+
+        const node* l_xor = disjoin(conjoin(l_a, invert(l_b)), conjoin(invert(l_a), l_b));
+
+        for (uint32_t l_threads : { 1, 3 })
+        {
+            const std::vector<const node*> l_outputs = build_outputs(l_netlist, l_threads);
+
+            assert(l_outputs[0] == disjoin(conjoin(l_xor, invert(l_c)), conjoin(invert(l_xor), l_c)));
+            assert(l_outputs[1] == disjoin(disjoin(conjoin(l_a, l_b), conjoin(l_a, l_c)), conjoin(l_b, l_c)));
+            assert(l_outputs[2] == invert(conjoin(l_a, l_b)));
+            assert(l_outputs[3] == ZERO);
+        }
+    }
+
+    /// The same exclusive-or and its inversion as an
+    ///     AIG, in both AIGER formats.
+    const std::string l_aag = "aag 5 2 0 2 3\n2\n4\n11\n10\n6 2 4\n8 3 5\n10 7 9\ni0 x\ni1 y\no0 xnor\no1 xor\nc\na comment\n";
+    const std::string l_aig = std::string("aig 5 2 0 2 3\n11\n10\n") + "\x02\x02\x03\x02\x01\x02" + "i0 x\ni1 y\no0 xnor\no1 xor\n";
+
+    for (const std::string& l_file : { l_aag, l_aig })
+    {
+        std::stringstream l_text(l_file);
+
+        netlist l_netlist;
+
+        assert(!read_aiger(l_text, l_netlist));
+
+        assert((l_netlist.m_inputs == std::vector<std::string>{ "x", "y" }));
+        assert((l_netlist.m_output_names == std::vector<std::string>{ "xnor", "xor" }));
+
+        const std::vector<const node*> l_outputs = build_outputs(l_netlist);
+
+        const node* l_xor = disjoin(conjoin(l_a, invert(l_b)), conjoin(invert(l_a), l_b));
+
+        assert(l_outputs[0] == invert(l_xor));
+        assert(l_outputs[1] == l_xor);
+    }
+
+    /// Random networks agree with simulation whichever
+    ///     threads build them, and however often their
+    ///     dags are compacted.
+    {
+        std::mt19937_64 l_random(0);
+
+        std::string l_text = ".inputs";
+
+        for (uint32_t i = 0; i < 14; i++)
+            l_text += " x" + std::to_string(i);
+
+        l_text += "\n.outputs g1999 g1998 g1500 g1000 g999\n";
+
+        const char* const l_covers[] = { "11 1\n", "00 0\n", "01 1\n10 1\n", "1- 1\n-0 1\n" };
+
+        for (uint32_t i = 0; i < 2000; i++)
+        {
+            const auto l_fanin = [&]
+            {
+                const uint32_t l_signal = l_random() % (14 + i);
+                return l_signal < 14 ? "x" + std::to_string(l_signal) : "g" + std::to_string(l_signal - 14);
+            };
+
+            l_text += ".names " + l_fanin() + " " + l_fanin() + " g" + std::to_string(i) + "\n" + l_covers[l_random() % 4];
+        }
+
+        std::stringstream l_stream(l_text);
+
+        netlist l_netlist;
+
+        assert(!read_blif(l_stream, l_netlist));
+
+        const std::vector<const node*> l_outputs = build_outputs(l_netlist, 1);
+
+        assert(build_outputs(l_netlist, 4) == l_outputs);
+        assert(build_outputs(l_netlist, 2, 64) == l_outputs);
+
+        for (uint32_t l_trial = 0; l_trial < 64; l_trial++)
+        {
+            const uint64_t l_input = l_random();
+
+            const std::vector<bool> l_expected = simulate(l_netlist, l_input);
+
+            for (size_t k = 0; k < l_outputs.size(); k++)
+                assert(evaluate(l_outputs[k], std::bitset<14>(l_input)) == l_expected[k]);
+        }
+    }
+
+    /// Malformed netlists report where.
+    for (const auto& [l_text, l_line, l_position] : std::initializer_list<std::tuple<const char*, size_t, size_t>>{
+        { ".inputs a\n.outputs b\n", 1, 9 },
+        { ".inputs a\n.names a\n1\n", 1, 7 },
+        { ".inputs a\n.names b c\n1 1\n.names c b\n1 1\n", 1, 0 },
+        { ".inputs a\n.latch a b 0\n", 1, 0 },
+        { ".inputs a b\n.names a b c\n11 1\n00 0\n", 3, 3 },
+        { "11 1\n", 0, 0 },
+    })
+    {
+        std::stringstream l_stream(l_text);
+
+        netlist l_netlist;
+
+        const std::optional<line_error> l_error = read_blif(l_stream, l_netlist);
+
+        assert(l_error && l_error->m_line == l_line && l_error->m_error.m_position == l_position);
+    }
+
+    for (const auto& [l_text, l_position] : std::initializer_list<std::pair<const char*, size_t>>{
+        { "aag 3 1 1 1 0\n2\n4 2\n6\n", 0 },
+        { "aag 3 1 0 1 1\n2\n6\n6 2 5\n", 18 },
+        { "aag 3 1 0 1 1\n2\n6\n6 2 6\n", 18 },
+        { "aig 3 1 0 1 1\n6\n\x02", 17 },
+    })
+    {
+        std::stringstream l_stream(l_text);
+
+        netlist l_netlist;
+
+        const std::optional<parse_error> l_error = read_aiger(l_stream, l_netlist);
+
+        assert(l_error && l_error->m_position == l_position);
+    }
+
+}
+
+void test_print_shared(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// Parity's cofactors are shared at every level, so its
+    ///     tree form doubles in length with each variable.
+    const auto l_parity = [](uint32_t a_variables)
+    {
+        const node* l_result = ZERO;
+
+        for (uint32_t i = a_variables; i-- > 0;)
+            l_result = disjoin(conjoin(literal(i, false), l_result), conjoin(literal(i, true), invert(l_result)));
+
+        return l_result;
+    };
+
+    const auto l_read = [](const std::string& a_text)
+    {
+        std::istringstream l_istream(a_text);
+
+        const node* l_result = nullptr;
+
+        assert(!read_shared(l_istream, l_result));
+
+        return l_result;
+    };
+
+    {
+        const node* l_function = l_parity(12);
+
+        std::stringstream l_tree;
+        std::stringstream l_shared;
+
+        l_tree << l_function;
+
+        print_shared(l_shared, l_function);
+
+        /// Both nodes of each level below the first are shared,
+        ///     so are defined once each, before the root's line.
+        const std::string l_text = l_shared.str();
+
+        assert(std::count(l_text.begin(), l_text.end(), '\n') == 21);
+        assert(l_text.size() * 50 < l_tree.str().size());
+
+        assert(l_read(l_shared.str()) == l_function);
+
+        /// A fresh dag reads back the same structure.
+        dag l_other;
+
+        global_node_sink::bind(&l_other);
+
+        std::stringstream l_reprinted;
+
+        print_shared(l_reprinted, l_read(l_shared.str()));
+
+        assert(l_reprinted.str() == l_shared.str());
+
+        global_node_sink::bind(&l_nodes);
+    }
+
+    /// A function without sharing prints as operator<< does.
+    {
+        const node* l_function = disjoin(conjoin(literal(0, true), literal(2, false)), literal(1, true));
+
+        std::stringstream l_tree;
+        std::stringstream l_shared;
+
+        l_tree << l_function;
+
+        print_shared(l_shared, l_function);
+
+        assert(l_shared.str() == l_tree.str() + "\n");
+    }
+
+    /// Constants are written so as to read back.
+    for (const node* l_constant : { ZERO, ONE })
+    {
+        std::stringstream l_shared;
+
+        print_shared(l_shared, l_constant);
+
+        assert(l_read(l_shared.str()) == l_constant);
+    }
+
+    /// Names are written and read back.
+    {
+        symbol_table& l_symbols = l_nodes.symbols();
+
+        for (uint32_t i = 0; i < 6; i++)
+            l_symbols.assign("x" + std::to_string(i), i);
+
+        const node* l_function = l_parity(6);
+
+        std::stringstream l_shared;
+
+        print_shared(l_shared, l_function, l_symbols);
+
+        assert(l_shared.str().find('[') == std::string::npos);
+        assert(l_read(l_shared.str()) == l_function);
+    }
+
+    /// Blank lines are skipped, and spacing is free.
+    assert(l_read("\n$0 = [1]' + [1] [2]\n\n$1=[1]\n  ([0]'$0+[0] $1)  \n\n") ==
+        disjoin(conjoin(literal(0, false), disjoin(literal(1, false), conjoin(literal(1, true), literal(2, true)))),
+                conjoin(literal(0, true), literal(1, true))));
+
+    /// Malformed forms are reported by line and position.
+    const auto l_error = [](const std::string& a_text)
+    {
+        std::istringstream l_istream(a_text);
+
+        const node* l_result = nullptr;
+
+        return read_shared(l_istream, l_result);
+    };
+
+    assert(l_error("$1 = [0]\n[0]")->m_line == 0);
+    assert(l_error("$1 = [0]\n[0]")->m_error.m_message == "definitions must be numbered in turn");
+    assert(l_error("$0 = [0]\n[1] $1")->m_line == 1);
+    assert(l_error("$0 = [0]\n[1] $1")->m_error.m_position == 4);
+    assert(l_error("$0 = [0]\n[1] $1")->m_error.m_message == "undefined reference");
+    assert(l_error("$0 = [0]$0\n$0")->m_error.m_position == 8);
+    assert(l_error("$0 = ([0]\n$0")->m_error.m_position == 5);
+    assert(l_error("$0 = [0]\n$\n")->m_error.m_message == "malformed reference, expected $<index>");
+    assert(l_error("[0]\n[1]")->m_line == 1);
+    assert(l_error("[0]\n[1]")->m_error.m_message == "text after the function");
+    assert(l_error("$0 = [0]\n\n")->m_line == 2);
+    assert(l_error("$0 = [0]\n\n")->m_error.m_message == "missing function");
+
+    /// The plain notation has no definitions to refer to.
+    ast l_ast;
+
+    assert(parse("[0] $0", l_ast)->m_position == 4);
+
+}
+
+void test_expression_writer(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    symbol_table& l_symbols = l_nodes.symbols();
+
+    l_symbols.assign("a", 1);
+    l_symbols.assign("bus[2]", 3);
+
+    std::mt19937_64 l_random(0);
+
+    std::vector<const node*> l_functions = { ZERO, ONE, literal(0, true), literal(3, false) };
+
+    /// Random covers over 8 variables.
+    for (int i = 0; i < 32; i++)
+    {
+        const node* l_function = ZERO;
+
+        for (int l_term = 0; l_term < 4; l_term++)
+        {
+            const node* l_product = ONE;
+
+            for (int k = 0; k < 3; k++)
+                l_product = conjoin(l_product, literal(l_random() % 8, l_random() % 2));
+
+            l_function = disjoin(l_function, l_product);
+        }
+
+        l_functions.push_back(l_function);
+    }
+
+    /// Written with a small buffer, which is flushed
+    ///     many times, and reused between functions.
+    for (size_t l_buffer_bytes : { size_t(1), size_t(7), WRITER_BUFFER_BYTES })
+    {
+        std::stringstream l_expected;
+        std::stringstream l_expected_named;
+        std::stringstream l_written;
+        std::stringstream l_written_named;
+
+        {
+            expression_writer l_writer(l_written, l_buffer_bytes);
+            expression_writer l_named_writer(l_written_named, l_symbols, l_buffer_bytes);
+
+            for (const node* l_function : l_functions)
+            {
+                l_expected << l_function << "\n";
+
+                print(l_expected_named, l_function, l_symbols) << "\n";
+
+                l_writer.write(l_function).write("\n");
+                l_named_writer.write(l_function).write("\n");
+            }
+        }
+
+        assert(l_written.str() == l_expected.str());
+        assert(l_written_named.str() == l_expected_named.str());
+        assert(l_written_named.str().find("bus[2]") != std::string::npos);
+    }
+
+    /// Text stays buffered until flushed.
+    std::stringstream l_ostream;
+
+    expression_writer l_writer(l_ostream);
+
+    l_writer.write(l_functions.back());
+
+    assert(l_ostream.str().empty());
+
+    l_writer.flush();
+
+    std::stringstream l_expected;
+
+    l_expected << l_functions.back();
+
+    assert(l_ostream.str() == l_expected.str());
+
+}
+
+void test_write_dot(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    l_nodes.symbols().assign("en", 2);
+
+    /// Marks are only held within an epoch.
+    {
+        const node* l_literal = literal(9, true);
+
+        const uint32_t l_epoch = l_nodes.next_epoch();
+
+        assert(l_nodes.next_epoch() == l_epoch + 1);
+        assert(l_literal->mark(l_epoch + 1));
+        assert(!l_literal->mark(l_epoch + 1));
+        assert(l_literal->mark(l_nodes.next_epoch()));
+    }
+
+    /// Parity over 5 variables has 9 nodes.
+    const node* l_parity = ZERO;
+
+    for (uint32_t i = 5; i-- > 0;)
+        l_parity = disjoin(conjoin(literal(i, false), l_parity), conjoin(literal(i, true), invert(l_parity)));
+
+    const node* l_roots[] = { l_parity, literal(4, false), ONE };
+
+    const auto l_count = [](const std::string& a_text, std::string_view a_pattern)
+    {
+        size_t l_result = 0;
+
+        for (size_t i = a_text.find(a_pattern); i != std::string::npos; i = a_text.find(a_pattern, i + 1))
+            l_result++;
+
+        return l_result;
+    };
+
+    std::stringstream l_dot;
+
+    write_dot(l_dot, l_roots);
+
+    const std::string l_text = l_dot.str();
+
+    /// Each node once, with its two edges, and the
+    ///     literal shared with the parity's cone.
+    assert(l_text.starts_with("digraph dag {\n"));
+    assert(l_text.ends_with("}\n"));
+    assert(l_count(l_text, "rank=same") == 9);
+    assert(l_count(l_text, "[style=dashed]") == 9);
+    assert(l_count(l_text, "subgraph level_3 ") == 2);
+    assert(l_count(l_text, "label=\"en\"") == 2);
+    assert(l_count(l_text, "label=\"[4]\"") == 2);
+    assert(l_count(l_text, "r2 -> one;") == 1);
+    assert(l_count(l_text, "-> elided") == 0);
+
+    /// A second export visits everything again.
+    {
+        std::stringstream l_again;
+
+        write_dot(l_again, l_roots);
+
+        assert(l_again.str() == l_text);
+    }
+
+    /// The top two levels: the root, and its two children,
+    ///     whose four edges lead to the elision.
+    {
+        std::stringstream l_capped;
+
+        write_dot(l_capped, l_roots, 2);
+
+        assert(l_count(l_capped.str(), "rank=same") == 3);
+        assert(l_count(l_capped.str(), "-> elided") == 5);
+    }
+
+    {
+        std::stringstream l_empty;
+
+        write_dot(l_empty, l_roots, 0);
+
+        assert(l_count(l_empty.str(), "rank=same") == 0);
+    }
+
+}
+
+void test_hdl(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const auto l_count = [](const std::string& a_text, std::string_view a_pattern)
+    {
+        size_t l_result = 0;
+
+        for (size_t i = a_text.find(a_pattern); i != std::string::npos; i = a_text.find(a_pattern, i + 1))
+            l_result++;
+
+        return l_result;
+    };
+
+    /// Parity over 6 variables, sharing its lower levels
+    ///     with a second function, and both constants.
+    const node* l_parity = ZERO;
+
+    for (uint32_t i = 6; i-- > 0;)
+        l_parity = disjoin(conjoin(literal(i, false), l_parity), conjoin(literal(i, true), invert(l_parity)));
+
+    const node* l_other = disjoin(conjoin(literal(0, true), l_parity->positive()), literal(2, false));
+
+    const node* l_roots[] = { l_parity, l_other, ONE, ZERO, l_parity };
+
+    /// The model reads back as the same functions.
+    {
+        std::stringstream l_blif;
+
+        write_blif(l_blif, l_roots, "parity");
+
+        const std::string l_text = l_blif.str();
+
+        assert(l_text.starts_with(".model parity\n.inputs x[0] x[1] x[2] x[3] x[4] x[5]\n.outputs y[0] y[1] y[2] y[3] y[4]\n"));
+        assert(l_text.ends_with(".end\n"));
+
+        netlist l_netlist;
+
+        assert(!read_blif(l_blif, l_netlist));
+
+        const std::vector<const node*> l_outputs = build_outputs(l_netlist, 1);
+
+        assert(std::equal(l_outputs.begin(), l_outputs.end(), std::begin(l_roots), std::end(l_roots)));
+    }
+
+    /// One wire per node, each after its children.
+    {
+        std::stringstream l_verilog;
+
+        write_verilog(l_verilog, l_roots, "parity");
+
+        const std::string l_text = l_verilog.str();
+
+        assert(l_text.starts_with("module parity(x, y);\n  input [5:0] x;\n  output [4:0] y;\n"));
+        assert(l_text.ends_with("endmodule\n"));
+
+        std::set<const node*> l_reachable;
+
+        std::vector<const node*> l_pending(std::begin(l_roots), std::end(l_roots));
+
+        while (!l_pending.empty())
+        {
+            const node* l_node = l_pending.back();
+
+            l_pending.pop_back();
+
+            if (l_node != ZERO && l_node != ONE && l_reachable.insert(l_node).second)
+            {
+                l_pending.push_back(l_node->negative());
+                l_pending.push_back(l_node->positive());
+            }
+        }
+
+        assert(l_count(l_text, "  wire n") == l_reachable.size());
+        assert(l_count(l_text, "  assign y[") == 5);
+        assert(l_count(l_text, "wire n0 = x[5] ? 1'b") == 1);
+        assert(l_count(l_text, "assign y[2] = 1'b1;") == 1);
+        assert(l_count(l_text, "assign y[3] = 1'b0;") == 1);
+
+        for (size_t l_wire = 0; l_wire < l_reachable.size(); l_wire++)
+            assert(l_text.find("n" + std::to_string(l_wire) + " ") < l_text.find("n" + std::to_string(l_wire) + ";"));
+    }
+
+    /// A minimized PLA, with don't-cares, reads back as
+    ///     functions between its on-sets and care sets.
+    {
+        std::stringstream l_text(
+            ".i 4\n"
+            ".o 3\n"
+            ".ilb a b c d\n"
+            ".ob f g h\n"
+            "11-- 100\n"
+            "1-1- 1-0\n"
+            "0-01 010\n"
+            "0--- 0-0\n"
+            ".e\n"
+        );
+
+        pla l_pla;
+
+        assert(!read_pla(l_text, l_pla));
+
+        std::stringstream l_blif;
+
+        write_blif(l_blif, l_pla, "cover");
+
+        assert(l_blif.str().starts_with(".model cover\n.inputs a b c d\n.outputs f g h\n"));
+        assert(l_count(l_blif.str(), ".names a g\n0 1\n.names h\n.end\n") == 1);
+
+        netlist l_netlist;
+
+        assert(!read_blif(l_blif, l_netlist));
+
+        const std::vector<const node*> l_outputs = build_outputs(l_netlist, 1);
+
+        for (size_t k = 0; k < 3; k++)
+        {
+            assert(conjoin(l_pla.m_on[k], invert(l_outputs[k])) == ZERO);
+            assert(conjoin(l_outputs[k], invert(disjoin(l_pla.m_on[k], l_pla.m_dont_care[k]))) == ZERO);
+        }
+
+        std::stringstream l_verilog;
+
+        write_verilog(l_verilog, l_pla, "cover");
+
+        assert(l_count(l_verilog.str(), "// x[3]: d\n") == 1);
+        assert(l_count(l_verilog.str(), "// y[1]: g\n") == 1);
+        assert(l_count(l_verilog.str(), "  input [3:0] x;\n  output [2:0] y;\n") == 1);
+        assert(l_count(l_verilog.str(), "assign y[0] = x[0] & x[2] | x[0] & x[1];") == 1);
+        assert(l_count(l_verilog.str(), "assign y[1] = ~x[0];") == 1);
+        assert(l_count(l_verilog.str(), "assign y[2] = 1'b0;") == 1);
+    }
+
+}
+
+void test_binary(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    l_nodes.symbols().assign("en", 1);
+    l_nodes.symbols().assign("unused", 40);
+
+    /// Parity over 8 variables, and a function
+    ///     sharing part of it.
+    const node* l_parity = ZERO;
+
+    for (uint32_t i = 8; i-- > 0;)
+        l_parity = disjoin(conjoin(literal(i, false), l_parity), conjoin(literal(i, true), invert(l_parity)));
+
+    const node* l_other = disjoin(conjoin(literal(1, true), l_parity->positive()->negative()), literal(9, false));
+
+    const node* l_roots[] = { l_parity, ONE, l_other, ZERO, l_parity };
+
+    std::stringstream l_binary;
+
+    write_binary(l_binary, l_roots);
+
+    const std::string l_bytes = l_binary.str();
+
+    assert(l_bytes.starts_with("FDAG\x01"));
+
+    /// Reading into the same dag finds the same nodes,
+    ///     through buffers of any size.
+    for (size_t l_buffer_bytes : { size_t(1), size_t(3), SERIALIZE_BUFFER_BYTES })
+    {
+        std::istringstream l_istream(l_bytes);
+
+        std::vector<const node*> l_read;
+
+        assert(!read_binary(l_istream, l_read, l_buffer_bytes));
+
+        assert(std::equal(l_read.begin(), l_read.end(), std::begin(l_roots), std::end(l_roots)));
+    }
+
+    /// A fresh dag receives the same structure and names,
+    ///     and only the names of the variables written.
+    {
+        dag l_fresh;
+
+        global_node_sink::bind(&l_fresh);
+
+        std::istringstream l_istream(l_bytes);
+
+        std::vector<const node*> l_read;
+
+        assert(!read_binary(l_istream, l_read));
+
+        assert(l_fresh.symbols().find("en") == 1);
+        assert(!l_fresh.symbols().find("unused"));
+
+        for (size_t i = 0; i < l_read.size(); i++)
+        {
+            std::stringstream l_expected;
+            std::stringstream l_actual;
+
+            l_expected << l_roots[i];
+            l_actual << l_read[i];
+
+            assert(l_actual.str() == l_expected.str());
+        }
+
+        /// The two copies of the parity are one.
+        assert(l_read[4] == l_read[0]);
+
+        global_node_sink::bind(&l_nodes);
+    }
+
+    /// Malformed data is reported at its offset.
+    const auto l_error = [](const std::string& a_bytes)
+    {
+        std::istringstream l_istream(a_bytes);
+
+        std::vector<const node*> l_read;
+
+        return read_binary(l_istream, l_read);
+    };
+
+    assert(l_error("FDAX")->m_position == 0);
+    assert(l_error("FDAG\x02")->m_message == "unsupported version");
+
+    for (size_t l_size = 5; l_size < l_bytes.size(); l_size++)
+        assert(l_error(l_bytes.substr(0, l_size)));
+
+    /// Names are assigned only once the whole dag has been read.
+    {
+        dag l_fresh;
+
+        global_node_sink::bind(&l_fresh);
+
+        for (size_t l_size = 5; l_size < l_bytes.size(); l_size++)
+        {
+            assert(l_error(l_bytes.substr(0, l_size)));
+            assert(l_fresh.symbols().size() == 0);
+        }
+
+        global_node_sink::bind(&l_nodes);
+    }
+
+    /// One node, one level, one root, no names: the level at
+    ///     depth 3 holding a node whose child would be itself.
+    assert(l_error(std::string("FDAG\x01\x01\x01\x01\x00\x03\x01\x02\x01\x02", 14))->m_position == 11);
+    assert(l_error(std::string("FDAG\x01\x01\x01\x01\x00\x03\x01\x00\x01\x02", 14)) == std::nullopt);
+    assert(l_error(std::string("FDAG\x01\x01\x01\x01\x00\x03\x01\x00\x01\x03", 14))->m_message == "root out of range");
+
+}
+
+void test_frozen_dag(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const std::string l_path = (std::filesystem::temp_directory_path() / "factor_test_frozen_dag.bin").string();
+
+    /// Parity over 7 variables, a function sharing
+    ///     part of it, and both constants.
+    const node* l_parity = ZERO;
+
+    for (uint32_t i = 7; i-- > 0;)
+        l_parity = disjoin(conjoin(literal(i, false), l_parity), conjoin(literal(i, true), invert(l_parity)));
+
+    const node* l_other = disjoin(conjoin(literal(1, true), l_parity->positive()->negative()), literal(9, false));
+
+    const node* l_roots[] = { l_parity, l_other, ZERO, ONE };
+
+    {
+        std::ofstream l_file(l_path, std::ios::binary);
+        write_frozen(l_file, l_roots);
+    }
+
+    /// Sections are aligned, and the file is whole blocks.
+    assert(std::filesystem::file_size(l_path) % FROZEN_ALIGNMENT == 0);
+
+    frozen_dag l_frozen;
+
+    assert(!l_frozen.open(l_path.c_str()));
+
+    assert(l_frozen.roots() == 4);
+    assert(l_frozen.variables() == 10);
+
+    for (uint64_t l_input = 0; l_input < 1024; l_input++)
+        for (size_t i = 0; i < 4; i++)
+            assert(l_frozen.evaluate(i, { &l_input, 1 }) == evaluate(l_roots[i], std::span<const uint64_t>(&l_input, 1)));
+
+    /// Reopening replaces the mapping.
+    {
+        std::ofstream l_file(l_path, std::ios::binary);
+        write_frozen(l_file, { &l_other, 1 });
+    }
+
+    assert(!l_frozen.open(l_path.c_str()));
+    assert(l_frozen.roots() == 1);
+
+    for (uint64_t l_input = 0; l_input < 1024; l_input++)
+        assert(l_frozen.evaluate(0, { &l_input, 1 }) == evaluate(l_other, std::span<const uint64_t>(&l_input, 1)));
+
+    /// A missing root is refused, as is any root
+    ///     when nothing is open.
+    {
+        const uint64_t l_input = 0;
+
+        frozen_dag l_unopened;
+
+        for (const frozen_dag* l_target : { &l_frozen, &l_unopened })
+        {
+            bool l_thrown = false;
+
+            try
+            {
+                l_target->evaluate(l_target->roots(), { &l_input, 1 });
+            }
+            catch (const std::out_of_range&)
+            {
+                l_thrown = true;
+            }
+
+            assert(l_thrown);
+        }
+    }
+
+    /// Too short an input is refused.
+    {
+        const uint64_t l_input = 0;
+
+        bool l_thrown = false;
+
+        try
+        {
+            l_frozen.evaluate(0, { &l_input, 0 });
+        }
+        catch (const std::invalid_argument&)
+        {
+            l_thrown = true;
+        }
+
+        assert(l_thrown);
+    }
+
+    /// A record whose child does not precede it is found on the
+    ///     walk that reaches it, rather than when opening.
+    {
+        std::string l_bytes;
+
+        {
+            std::stringstream l_binary;
+            write_frozen(l_binary, { &l_other, 1 });
+            l_bytes = l_binary.str();
+        }
+
+        frozen_header l_header;
+
+        std::memcpy(&l_header, l_bytes.data(), sizeof(l_header));
+
+        /// Point both children of the root record at itself.
+        const size_t l_root_record = l_header.m_records_offset + (l_header.m_nodes - 1) * sizeof(frozen_record);
+        const uint32_t l_self = l_header.m_nodes + 1;
+
+        std::memcpy(l_bytes.data() + l_root_record + offsetof(frozen_record, m_negative), &l_self, sizeof(l_self));
+        std::memcpy(l_bytes.data() + l_root_record + offsetof(frozen_record, m_positive), &l_self, sizeof(l_self));
+
+        std::ofstream(l_path, std::ios::binary) << l_bytes;
+
+        assert(!l_frozen.open(l_path.c_str()));
+
+        bool l_thrown = false;
+
+        try
+        {
+            const uint64_t l_input = 0;
+            l_frozen.evaluate(0, { &l_input, 1 });
+        }
+        catch (const std::runtime_error&)
+        {
+            l_thrown = true;
+        }
+
+        assert(l_thrown);
+
+        /// Headers that do not fit the file are refused.
+        std::ofstream(l_path, std::ios::binary) << l_bytes.substr(0, l_header.m_roots_offset);
+
+        assert(l_frozen.open(l_path.c_str())->m_position == offsetof(frozen_header, m_roots_offset));
+
+        std::ofstream(l_path, std::ios::binary) << "FDAGFRZX" << std::string(56, '\0');
+
+        assert(l_frozen.open(l_path.c_str())->m_position == 0);
+
+        std::ofstream(l_path, std::ios::binary) << "FDAG";
+
+        assert(l_frozen.open(l_path.c_str())->m_message == "truncated header");
+        assert(l_frozen.roots() == 0);
+    }
+
+    std::filesystem::remove(l_path);
+
+}
+
+void test_checkpoint(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    l_nodes.symbols().assign("en", 1);
+    l_nodes.symbols().assign("unused", 40);
+
+    const std::string l_path = (std::filesystem::temp_directory_path() / "factor_test_checkpoint.bin").string();
+
+    /// Parity over 8 variables, built through
+    ///     caches the checkpoint keeps.
+    std::map<std::set<const node*>, const node*> l_conjunctions;
+    std::map<std::set<const node*>, const node*> l_disjunctions;
+    std::map<const node*, const node*> l_inversions;
+
+    const auto l_parity = [&](
+        std::map<std::set<const node*>, const node*>& a_conjunctions,
+        std::map<std::set<const node*>, const node*>& a_disjunctions,
+        std::map<const node*, const node*>& a_inversions
+    )
+    {
+        const node* l_result = ZERO;
+
+        for (uint32_t i = 8; i-- > 0;)
+            l_result =
+                factor::join(
+                    a_disjunctions,
+                    ZERO,
+                    ONE,
+                    factor::join(a_conjunctions, ONE, ZERO, literal(i, false), l_result),
+                    factor::join(a_conjunctions, ONE, ZERO, literal(i, true), factor::invert(a_inversions, l_result))
+                );
+
+        return l_result;
+    };
+
+    const node* l_roots[] = { l_parity(l_conjunctions, l_disjunctions, l_inversions), ONE };
+
+    /// A node beneath no root is kept all the same.
+    literal(12, false);
+
+    save_checkpoint(l_path.c_str(), l_nodes, l_roots, { { &l_conjunctions, &l_disjunctions }, { &l_inversions } });
+
+    assert(!std::filesystem::exists(l_path + ".tmp"));
+
+    std::string l_bytes;
+
+    {
+        std::ifstream l_file(l_path, std::ios::binary);
+        l_bytes.assign(std::istreambuf_iterator<char>(l_file), {});
+    }
+
+    assert(l_bytes.starts_with("FCKP\x01"));
+
+    /// A fresh dag receives every node, every name,
+    ///     and the tables, translated.
+    {
+        dag l_fresh;
+
+        global_node_sink::bind(&l_fresh);
+
+        std::map<std::set<const node*>, const node*> l_restored_conjunctions;
+        std::map<std::set<const node*>, const node*> l_restored_disjunctions;
+        std::map<const node*, const node*> l_restored_inversions;
+
+        const checkpoint_tables l_tables = { { &l_restored_conjunctions, &l_restored_disjunctions }, { &l_restored_inversions } };
+
+        std::vector<const node*> l_read;
+
+        assert(!load_checkpoint(l_path.c_str(), l_read, l_tables));
+
+        assert(l_fresh.size() == l_nodes.size());
+        assert(l_fresh.symbols().find("en") == 1);
+        assert(l_fresh.symbols().find("unused") == 40);
+
+        assert(l_read.size() == 2);
+        assert(l_read[1] == ONE);
+
+        {
+            std::stringstream l_expected;
+            std::stringstream l_actual;
+
+            l_expected << l_roots[0];
+            l_actual << l_read[0];
+
+            assert(l_actual.str() == l_expected.str());
+        }
+
+        assert(l_restored_conjunctions.size() == l_conjunctions.size());
+        assert(l_restored_disjunctions.size() == l_disjunctions.size());
+        assert(l_restored_inversions.size() == l_inversions.size());
+
+        /// Resuming finds every result in the tables,
+        ///     so nothing is computed again.
+        assert(l_parity(l_restored_conjunctions, l_restored_disjunctions, l_restored_inversions) == l_read[0]);
+
+        assert(l_fresh.size() == l_nodes.size());
+        assert(l_restored_conjunctions.size() == l_conjunctions.size());
+        assert(l_restored_disjunctions.size() == l_disjunctions.size());
+        assert(l_restored_inversions.size() == l_inversions.size());
+
+        /// Each node keeps its number, so the
+        ///     checkpoint is written again unchanged.
+        std::stringstream l_again;
+
+        write_checkpoint(l_again, l_fresh, l_read, l_tables);
+
+        assert(l_again.str() == l_bytes);
+
+        global_node_sink::bind(&l_nodes);
+    }
+
+    /// A table referring to a node outside the dag is refused,
+    ///     leaving the previous checkpoint and no partial file.
+    {
+        dag l_other;
+
+        bool l_thrown = false;
+
+        try
+        {
+            save_checkpoint(l_path.c_str(), l_other, {}, { {}, { &l_inversions } });
+        }
+        catch (const std::out_of_range&)
+        {
+            l_thrown = true;
+        }
+
+        assert(l_thrown);
+        assert(!std::filesystem::exists(l_path + ".tmp"));
+
+        std::ifstream l_file(l_path, std::ios::binary);
+
+        assert(std::string(std::istreambuf_iterator<char>(l_file), {}) == l_bytes);
+    }
+
+    /// Malformed data is reported at its offset.
+    const auto l_error = [](const std::string& a_bytes, size_t a_joins, size_t a_inversions)
+    {
+        std::istringstream l_istream(a_bytes);
+
+        std::vector<std::map<std::set<const node*>, const node*>> l_joins(a_joins);
+        std::vector<std::map<const node*, const node*>> l_inversions(a_inversions);
+
+        checkpoint_tables l_tables;
+
+        for (auto& l_table : l_joins)
+            l_tables.m_joins.push_back(&l_table);
+        for (auto& l_table : l_inversions)
+            l_tables.m_inversions.push_back(&l_table);
+
+        std::vector<const node*> l_read;
+
+        return read_checkpoint(l_istream, l_read, l_tables);
+    };
+
+    assert(!l_error(l_bytes, 2, 1));
+    assert(l_error(l_bytes, 1, 1)->m_message == "join table count differs");
+    assert(l_error(l_bytes, 2, 0)->m_message == "inversion table count differs");
+    assert(l_error("FDAG\x01", 2, 1)->m_position == 0);
+
+    for (size_t l_size = 5; l_size < l_bytes.size(); l_size++)
+        assert(l_error(l_bytes.substr(0, l_size), 2, 1));
+
+    /// No nodes, levels, roots or names, and one join table
+    ///     whose entry refers to a node that does not exist.
+    assert(l_error(std::string("FCKP\x01\x00\x00\x00\x00\x01\x01\x01\x02\x01\x00", 15), 1, 0)->m_position == 12);
+    assert(l_error(std::string("FCKP\x01\x00\x00\x00\x00\x01\x01\x01\x01\x00\x00", 15), 1, 0) == std::nullopt);
+
+    std::filesystem::remove(l_path);
+
+    bool l_thrown = false;
+
+    try
+    {
+        std::vector<const node*> l_read;
+        load_checkpoint(l_path.c_str(), l_read, {});
+    }
+    catch (const std::system_error&)
+    {
+        l_thrown = true;
+    }
+
+    assert(l_thrown);
+
+}
+
+void unit_test_main(
+
+)
+{
+    constexpr bool ENABLE_DEBUG_LOGS = true;
+
+    TEST(test_node_constructor);
+    TEST(test_node_less_than_comparison);
+    TEST(test_node_ostream_inserter);
+    TEST(test_cache_macro);
+    TEST(test_node_contraction);
+    TEST(test_global_node_sink_bind);
+    TEST(test_global_node_sink_emplace);
+    TEST(test_literal);
+    TEST(test_cube);
+    TEST(test_clause);
+    TEST(test_dag_logic_padding);
+    TEST(test_dag_logic_invert);
+    TEST(test_dag_logic_join);
+    TEST(test_demorgans);
+    TEST(test_composite_function_logic);
+    TEST(test_equivalent_functions);
+    TEST(test_evaluate);
+    TEST(test_node_istream_extractor);
+    TEST(test_truth_table_64);
+    TEST(test_minimize_64);
+    TEST(test_batch_evaluator);
+    TEST(test_compiled_function);
+    TEST(test_generate_cpp);
+    TEST(test_incremental_evaluator);
+    TEST(test_expand);
+    TEST(test_from_truth_table);
+    TEST(test_from_cubes);
+    TEST(test_parse);
+    TEST(test_load_expression);
+    TEST(test_parse_lines);
+    TEST(test_symbol_table);
+    TEST(test_pla);
+    TEST(test_cnf);
+    TEST(test_netlist);
+    TEST(test_print_shared);
+    TEST(test_expression_writer);
+    TEST(test_write_dot);
+    TEST(test_hdl);
+    TEST(test_binary);
+    TEST(test_frozen_dag);
+    TEST(test_checkpoint);
+    
+}
+
+#pragma endregion
+
+////////////////////////////////////////////
+//////////////// BENCHMARKS ////////////////
+////////////////////////////////////////////
+#pragma region BENCHMARKS
+
+#define BENCHMARK(void_fn) \
+    std::cout << "BENCHMARK: " << #void_fn << std::endl; \
+    void_fn();
+
+/// Returns the mean wall-clock nanoseconds per
+///     call over the argued number of calls.
+template<typename FUNCTION>
+double nanoseconds_per_call(
+    size_t a_calls,
+    const FUNCTION& a_function
+)
+{
+    const auto l_start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < a_calls; i++)
+        a_function(i);
+
+    const auto l_stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(l_stop - l_start).count() / a_calls;
+
+}
+
+/// Builds a deep, heavily shared function over 16 variables:
+///     the middle bit of the product of two 8-bit operands.
+const node* benchmark_function(
+
+)
+{
+    std::list<const node*> l_x;
+    std::list<const node*> l_y;
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        l_x.push_back(literal(i, true));
+        l_y.push_back(literal(8 + i, true));
+    }
+
+    return *std::next(multiply(l_x, l_y).begin(), 8);
+
+}
+
+void benchmark_compiled_function(
+
+)
+{
+    constexpr size_t QUERIES = 1 << 20;
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_function = benchmark_function();
+
+    compiled_function l_compiled(l_function);
+
+    std::mt19937_64 l_random(0);
+
+    std::vector<std::vector<bool>> l_unpacked(1024, std::vector<bool>(16));
+    std::vector<uint64_t> l_packed(1024);
+
+    for (size_t i = 0; i < l_packed.size(); i++)
+    {
+        l_packed[i] = l_random() & 0xFFFF;
+
+        for (uint32_t v = 0; v < 16; v++)
+            l_unpacked[i][v] = (l_packed[i] >> v) & 1;
+    }
+
+    size_t l_ones = 0;
+
+    const double l_pointer = nanoseconds_per_call(
+        QUERIES,
+        [&](size_t i)
+        {
+            l_ones += evaluate(l_function, l_unpacked[i % 1024]);
+        }
+    );
+
+    const double l_flat = nanoseconds_per_call(
+        QUERIES,
+        [&](size_t i)
+        {
+            l_ones += l_compiled.evaluate(std::span(&l_packed[i % 1024], 1));
+        }
+    );
+
+    std::cout
+        << "    " << l_compiled.records().size() << " records, "
+        << l_pointer << " ns/query (pointer), "
+        << l_flat << " ns/query (compiled) "
+        << "[" << l_ones << "]" << std::endl;
+
+}
+
+void benchmark_packed_evaluate(
+
+)
+{
+    constexpr size_t QUERIES = 1 << 20;
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_function = benchmark_function();
+
+    std::mt19937_64 l_random(0);
+
+    std::vector<std::vector<bool>> l_unpacked(1024, std::vector<bool>(16));
+    std::vector<uint64_t> l_packed(1024);
+    std::vector<std::bitset<16>> l_bitsets(1024);
+
+    for (size_t i = 0; i < l_packed.size(); i++)
+    {
+        l_packed[i] = l_random() & 0xFFFF;
+        l_bitsets[i] = std::bitset<16>(l_packed[i]);
+
+        for (uint32_t v = 0; v < 16; v++)
+            l_unpacked[i][v] = (l_packed[i] >> v) & 1;
+    }
+
+    size_t l_ones = 0;
+
+    /// The unpacked overload is timed including the
+    ///     construction of its vector, as callers pay it.
+    const double l_vector = nanoseconds_per_call(
+        QUERIES,
+        [&](size_t i)
+        {
+            std::vector<bool> l_input(16);
+
+            for (uint32_t v = 0; v < 16; v++)
+                l_input[v] = (l_packed[i % 1024] >> v) & 1;
+
+            l_ones += evaluate(l_function, l_input);
+        }
+    );
+
+    const double l_prebuilt = nanoseconds_per_call(
+        QUERIES,
+        [&](size_t i)
+        {
+            l_ones += evaluate(l_function, l_unpacked[i % 1024]);
+        }
+    );
+
+    const double l_span = nanoseconds_per_call(
+        QUERIES,
+        [&](size_t i)
+        {
+            l_ones += evaluate(l_function, std::span(&l_packed[i % 1024], 1));
+        }
+    );
+
+    const double l_bitset = nanoseconds_per_call(
+        QUERIES,
+        [&](size_t i)
+        {
+            l_ones += evaluate(l_function, l_bitsets[i % 1024]);
+        }
+    );
+
+    std::cout
+        << "    " << l_vector << " ns/query (vector<bool>), "
+        << l_prebuilt << " ns/query (prebuilt vector<bool>), "
+        << l_span << " ns/query (span), "
+        << l_bitset << " ns/query (bitset) "
+        << "[" << l_ones << "]" << std::endl;
+
+}
+
+void benchmark_expand(
+
+)
+{
+    constexpr uint32_t VARIABLES = 28;
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// A product bit over the first 16 variables, mixed
+    ///     with the parity of the remaining twelve.
+    const node* l_function = benchmark_function();
+
+    for (uint32_t i = 16; i < VARIABLES; i++)
+        l_function = exor(l_function, literal(i, true));
+
+    for (uint32_t l_threads : { 1U, std::max(1U, std::thread::hardware_concurrency()) })
+    {
+        std::vector<uint64_t> l_table;
+
+        const double l_nanoseconds = nanoseconds_per_call(
+            1,
+            [&](size_t)
+            {
+                l_table = expand(l_function, VARIABLES, l_threads);
+            }
+        );
+
+        std::cout
+            << "    " << VARIABLES << " variables, " << l_threads << " thread(s): "
+            << l_nanoseconds / 1e6 << " ms "
+            << "[" << l_table[l_table.size() / 3] << "]" << std::endl;
+
+    }
+
+}
+
+void benchmark_from_truth_table(
+
+)
+{
+    constexpr uint32_t VARIABLES = 28;
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_function = benchmark_function();
+
+    for (uint32_t i = 16; i < VARIABLES; i++)
+        l_function = exor(l_function, literal(i, true));
+
+    const std::vector<uint64_t> l_table = expand(l_function, VARIABLES);
+
+    for (uint32_t l_threads : { 1U, std::max(1U, std::thread::hardware_concurrency()) })
+    {
+        dag l_result_nodes;
+
+        global_node_sink::bind(&l_result_nodes);
+
+        const node* l_result = nullptr;
+
+        const double l_nanoseconds = nanoseconds_per_call(
+            1,
+            [&](size_t)
+            {
+                l_result = from_truth_table(l_table, VARIABLES, l_threads);
+            }
+        );
+
+        std::cout
+            << "    " << VARIABLES << " variables, " << l_threads << " thread(s): "
+            << l_nanoseconds / 1e6 << " ms, "
+            << l_result_nodes.size() << " nodes" << std::endl;
+
+    }
+
+}
+
+void benchmark_from_cubes(
+
+)
+{
+    constexpr size_t CUBES = 1 << 22;
+    constexpr uint32_t VARIABLES = 32;
+
+    std::mt19937_64 l_random(0);
+
+    /// Random minterms over the low half of the variables
+    ///     with the high half fixed by a few patterns.
+    std::string l_storage(CUBES * VARIABLES, '0');
+    std::vector<std::string_view> l_cubes;
+
+    for (size_t i = 0; i < CUBES; i++)
+    {
+        char* l_cube = &l_storage[i * VARIABLES];
+        const uint64_t l_bits = l_random();
+
+        for (uint32_t v = 0; v < VARIABLES; v++)
+            l_cube[v] = v < 16 && (i & 7) == 0 ? '-' : "01"[(l_bits >> (v < 16 ? v : v % 4)) & 1];
+
+        l_cubes.emplace_back(l_cube, VARIABLES);
+    }
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const double l_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            from_cubes(l_cubes);
+        }
+    );
+
+    std::cout
+        << "    " << CUBES << " cubes: "
+        << l_nanoseconds / 1e6 << " ms, "
+        << l_nodes.size() << " nodes" << std::endl;
+
+}
+
+void benchmark_parse(
+
+)
+{
+    constexpr size_t CUBES = 4096;
+
+    std::string l_printed;
+    std::string l_cover;
+
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        std::stringstream l_ss;
+
+        l_ss << benchmark_function();
+
+        l_printed = l_ss.str();
+    }
+
+    /// A flat sum of random products over 16 variables.
+    std::mt19937_64 l_random(0);
+
+    for (size_t i = 0; i < CUBES; i++)
+    {
+        if (i > 0)
+            l_cover += "+";
+
+        for (uint32_t k = 0; k < 6; k++)
+            l_cover += "[" + std::to_string(l_random() % 16) + "]" + (l_random() % 2 ? "'" : "");
+    }
+
+    for (const std::string& l_text : { l_printed, l_cover })
+    {
+        const double l_extractor = nanoseconds_per_call(
+            1,
+            [&](size_t)
+            {
+                dag l_nodes;
+
+                global_node_sink::bind(&l_nodes);
+
+                std::stringstream l_ss(l_text);
+
+                const node* l_node;
+
+                l_ss >> l_node;
+            }
+        );
+
+        ast l_ast;
+
+        const double l_parser = nanoseconds_per_call(
+            1,
+            [&](size_t)
+            {
+                dag l_nodes;
+
+                global_node_sink::bind(&l_nodes);
+
+                parse(l_text, l_ast);
+                build(l_ast);
+            }
+        );
+
+        std::cout
+            << "    " << l_text.size() << " chars: "
+            << l_extractor / 1e6 << " ms (operator>>), "
+            << l_parser / 1e6 << " ms (parse + build)" << std::endl;
+
+    }
+
+}
+
+void benchmark_load_expression(
+
+)
+{
+    constexpr uint32_t COPIES = 128;
+
+    const std::string l_path = (std::filesystem::temp_directory_path() / "factor_benchmark_load_expression.txt").string();
+
+    /// A sum of copies of the benchmark function, each
+    ///     selected by a distinct minterm of 7 further variables.
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        std::stringstream l_printed;
+
+        l_printed << benchmark_function();
+
+        std::ofstream l_file(l_path, std::ios::binary);
+
+        for (uint32_t i = 0; i < COPIES; i++)
+        {
+            l_file << (i > 0 ? "+" : "");
+
+            for (uint32_t k = 0; k < 7; k++)
+                l_file << "[" << 16 + k << "]" << ((i >> k) & 1 ? "" : "'");
+
+            l_file << "(" << l_printed.str() << ")";
+        }
+    }
+
+    const double l_extractor = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            dag l_nodes;
+
+            global_node_sink::bind(&l_nodes);
+
+            std::ifstream l_file(l_path, std::ios::binary);
+
+            const node* l_node;
+
+            l_file >> l_node;
+        }
+    );
+
+    const double l_loader = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            dag l_nodes;
+
+            global_node_sink::bind(&l_nodes);
+
+            const node* l_node;
+
+            load_expression(l_path.c_str(), l_node);
+        }
+    );
+
+    std::cout
+        << "    " << std::filesystem::file_size(l_path) << " bytes: "
+        << l_extractor / 1e6 << " ms (operator>>), "
+        << l_loader / 1e6 << " ms (load_expression)" << std::endl;
+
+    std::filesystem::remove(l_path);
+
+}
+
+void benchmark_parse_lines(
+
+)
+{
+    constexpr size_t LINES = 1 << 12;
+
+    /// Lines of small random covers over 24 variables.
+    std::mt19937_64 l_random(0);
+
+    std::string l_text;
+
+    for (size_t i = 0; i < LINES; i++)
+    {
+        for (uint32_t l_term = 0; l_term < 8; l_term++)
+        {
+            if (l_term > 0)
+                l_text += "+";
+
+            for (uint32_t k = 0; k < 4; k++)
+                l_text += "[" + std::to_string(l_random() % 24) + "]" + (l_random() % 2 ? "'" : "");
+        }
+
+        l_text += "\n";
+    }
+
+    for (uint32_t l_threads : { 1U, std::thread::hardware_concurrency() })
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        std::vector<line_error> l_errors;
+
+        const double l_nanoseconds = nanoseconds_per_call(
+            1,
+            [&](size_t)
+            {
+                parse_lines(l_text, l_errors, l_threads);
+            }
+        );
+
+        std::cout
+            << "    " << LINES << " lines, " << l_threads << " threads: "
+            << l_nanoseconds / 1e6 << " ms, "
+            << l_nodes.size() << " nodes" << std::endl;
+    }
+
+}
+
+void benchmark_pla(
+
+)
+{
+    constexpr size_t CUBES = 1 << 14;
+
+    /// Random cubes over 24 inputs and 4 outputs,
+    ///     each input absent from one cube in 24.
+    std::mt19937_64 l_random(0);
+
+    std::string l_text = ".i 24\n.o 4\n";
+
+    for (size_t i = 0; i < CUBES; i++)
+    {
+        for (uint32_t v = 0; v < 24; v++)
+            l_text += l_random() % 24 ? "01"[l_random() % 2] : '-';
+
+        l_text += " ";
+
+        for (uint32_t k = 0; k < 4; k++)
+            l_text += "01"[l_random() % 2];
+
+        l_text += "\n";
+    }
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    pla l_pla;
+
+    const double l_read = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::stringstream l_stream(l_text);
+
+            read_pla(l_stream, l_pla);
+        }
+    );
+
+    std::stringstream l_written;
+
+    const double l_write = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            write_pla(l_written, l_pla);
+        }
+    );
+
+    std::cout
+        << "    " << CUBES << " cubes: "
+        << l_read / 1e6 << " ms (read_pla), "
+        << l_write / 1e6 << " ms (write_pla, "
+        << std::count(std::istreambuf_iterator<char>(l_written), {}, '\n') << " lines)" << std::endl;
+
+}
+
+void benchmark_conjoin_clauses(
+
+)
+{
+    /// Random 3-clauses over short windows of the order,
+    ///     given in random order, as banded formulas from
+    ///     circuits arrive once their clauses are shuffled.
+    std::mt19937_64 l_random(0);
+
+    cnf l_cnf{ 200 };
+
+    for (uint32_t l_clause = 0; l_clause < 600; l_clause++)
+    {
+        const uint32_t l_window = l_random() % 192;
+
+        auto& l_literals = l_cnf.m_clauses.emplace_back();
+
+        for (uint32_t k = 0; k < 3; k++)
+            l_literals.emplace_back(l_window + l_random() % 8, l_random() % 2);
+    }
+
+    for (conjunction_schedule l_schedule : { FILE_ORDER, BUCKETS })
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        conjunction_statistics l_statistics;
+
+        const node* l_product = conjoin_clauses(l_cnf, l_statistics, l_schedule);
+
+        std::cout
+            << "    " << (l_schedule == FILE_ORDER ? "file order" : "buckets") << ": "
+            << l_statistics.m_elapsed.count() / 1e6 << " ms, "
+            << l_statistics.m_peak_product_nodes << " peak product nodes, "
+            << l_statistics.m_dag_nodes << " dag nodes"
+            << (l_product == ZERO ? ", unsatisfiable" : "") << std::endl;
+    }
+
+}
+
+void benchmark_netlist(
+
+)
+{
+    constexpr uint32_t INPUTS = 256;
+    constexpr uint32_t OUTPUTS = 4096;
+    constexpr uint32_t CHAIN = 24;
+
+    /// Each output is a chain of random two-input gates
+    ///     along a window of the inputs.
+    std::mt19937_64 l_random(0);
+
+    std::string l_text = ".model chains\n.inputs";
+
+    for (uint32_t i = 0; i < INPUTS; i++)
+        l_text += " x" + std::to_string(i);
+
+    l_text += "\n.outputs";
+
+    for (uint32_t i = 0; i < OUTPUTS; i++)
+        l_text += " y" + std::to_string(i);
+
+    l_text += "\n";
+
+    const char* const l_covers[] = { "11 1\n", "00 0\n", "01 1\n10 1\n", "1- 1\n-0 1\n" };
+
+    for (uint32_t i = 0; i < OUTPUTS; i++)
+    {
+        const uint32_t l_window = l_random() % (INPUTS - CHAIN);
+
+        std::string l_previous = "x" + std::to_string(l_window);
+
+        for (uint32_t k = 1; k <= CHAIN; k++)
+        {
+            const std::string l_gate = k == CHAIN ? "y" + std::to_string(i) : "g" + std::to_string(i) + "_" + std::to_string(k);
+
+            l_text += ".names " + l_previous + " x" + std::to_string(l_window + k) + " " + l_gate + "\n" + l_covers[l_random() % 4];
+
+            l_previous = l_gate;
+        }
+    }
+
+    l_text += ".end\n";
+
+    netlist l_netlist;
+
+    const double l_read = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::stringstream l_stream(l_text);
+
+            read_blif(l_stream, l_netlist);
+        }
+    );
+
+    std::cout
+        << "    " << l_netlist.m_gates.size() << " gates: "
+        << l_read / 1e6 << " ms (read_blif)" << std::endl;
+
+    for (uint32_t l_threads : { 1U, std::thread::hardware_concurrency() })
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        const double l_build = nanoseconds_per_call(
+            1,
+            [&](size_t)
+            {
+                build_outputs(l_netlist, l_threads);
+            }
+        );
+
+        std::cout
+            << "    " << l_threads << " threads: "
+            << l_build / 1e6 << " ms, "
+            << l_nodes.size() << " nodes" << std::endl;
+    }
+
+}
+
+void benchmark_print_shared(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// Parity over 20 variables, whose tree form
+    ///     is already too large to be useful.
+    const node* l_parity = ZERO;
+
+    for (uint32_t i = 20; i-- > 0;)
+        l_parity = disjoin(conjoin(literal(i, false), l_parity), conjoin(literal(i, true), invert(l_parity)));
+
+    std::string l_tree;
+    std::string l_shared;
+
+    const double l_tree_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::stringstream l_ostream;
+            l_ostream << l_parity;
+            l_tree = l_ostream.str();
+        }
+    );
+
+    const double l_shared_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::stringstream l_ostream;
+            print_shared(l_ostream, l_parity);
+            l_shared = l_ostream.str();
+        }
+    );
+
+    std::cout
+        << "    parity of 20, tree: " << l_tree.size() << " bytes, " << l_tree_nanoseconds / 1e6 << " ms; shared: "
+        << l_shared.size() << " bytes, " << l_shared_nanoseconds / 1e6 << " ms" << std::endl;
+
+    /// At least half of 600 variables, whose dag has a node
+    ///     for each variable and count still needed.
+    constexpr uint32_t VARIABLES = 600;
+
+    std::vector<const node*> l_thresholds(VARIABLES / 2 + 1, ZERO);
+
+    l_thresholds[0] = ONE;
+
+    for (uint32_t i = VARIABLES; i-- > 0;)
+        for (uint32_t k = VARIABLES / 2; k > 0; k--)
+            l_thresholds[k] = l_nodes.emplace(i, l_thresholds[k], l_thresholds[k - 1]);
+
+    const node* l_majority = l_thresholds[VARIABLES / 2];
+
+    const double l_print_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::stringstream l_ostream;
+            print_shared(l_ostream, l_majority);
+            l_shared = l_ostream.str();
+        }
+    );
+
+    dag l_read_nodes;
+
+    global_node_sink::bind(&l_read_nodes);
+
+    const double l_read_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::istringstream l_istream(l_shared);
+            const node* l_result;
+            read_shared(l_istream, l_result);
+        }
+    );
+
+    std::cout
+        << "    majority of " << VARIABLES << ", " << l_nodes.size() << " nodes: "
+        << l_shared.size() << " bytes, print " << l_print_nanoseconds / 1e6 << " ms, read "
+        << l_read_nanoseconds / 1e6 << " ms" << std::endl;
+
+}
+
+void benchmark_expression_writer(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// Parity over 20 variables, some 8 MB in tree form.
+    const node* l_parity = ZERO;
+
+    for (uint32_t i = 20; i-- > 0;)
+        l_parity = disjoin(conjoin(literal(i, false), l_parity), conjoin(literal(i, true), invert(l_parity)));
+
+    size_t l_bytes = 0;
+
+    const double l_ostream_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::ostringstream l_ostream;
+            l_ostream << l_parity;
+            l_bytes = l_ostream.tellp();
+        }
+    );
+
+    const double l_writer_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::ostringstream l_ostream;
+            expression_writer(l_ostream).write(l_parity);
+        }
+    );
+
+    std::cout
+        << "    " << l_bytes << " bytes, operator<<: " << l_ostream_nanoseconds / 1e6
+        << " ms, expression_writer: " << l_writer_nanoseconds / 1e6 << " ms" << std::endl;
+
+}
+
+void benchmark_write_dot(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// At least half of 600 variables.
+    constexpr uint32_t VARIABLES = 600;
+
+    std::vector<const node*> l_thresholds(VARIABLES / 2 + 1, ZERO);
+
+    l_thresholds[0] = ONE;
+
+    for (uint32_t i = VARIABLES; i-- > 0;)
+        for (uint32_t k = VARIABLES / 2; k > 0; k--)
+            l_thresholds[k] = l_nodes.emplace(i, l_thresholds[k], l_thresholds[k - 1]);
+
+    const node* l_majority = l_thresholds[VARIABLES / 2];
+
+    for (uint32_t l_levels : { 16U, UINT32_MAX })
+    {
+        const std::filesystem::path l_path = std::filesystem::temp_directory_path() / "benchmark_write_dot.dot";
+
+        const double l_nanoseconds = nanoseconds_per_call(
+            1,
+            [&](size_t)
+            {
+                std::ofstream l_file(l_path);
+                write_dot(l_file, { &l_majority, 1 }, l_levels);
+            }
+        );
+
+        std::cout
+            << "    majority of " << VARIABLES << ", "
+            << (l_levels == UINT32_MAX ? std::string("all") : std::to_string(l_levels)) << " levels: "
+            << std::filesystem::file_size(l_path) << " bytes, " << l_nanoseconds / 1e6 << " ms" << std::endl;
+
+        std::filesystem::remove(l_path);
+    }
+
+}
+
+void benchmark_hdl(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// At least half of 2000 variables, which
+    ///     has about a million nodes.
+    constexpr uint32_t VARIABLES = 2000;
+
+    std::vector<const node*> l_thresholds(VARIABLES / 2 + 1, ZERO);
+
+    l_thresholds[0] = ONE;
+
+    for (uint32_t i = VARIABLES; i-- > 0;)
+        for (uint32_t k = VARIABLES / 2; k > 0; k--)
+            l_thresholds[k] = l_nodes.emplace(i, l_thresholds[k], l_thresholds[k - 1]);
+
+    const node* l_majority = l_thresholds[VARIABLES / 2];
+
+    const std::filesystem::path l_path = std::filesystem::temp_directory_path() / "benchmark_hdl";
+
+    for (const char* l_format : { "verilog", "blif" })
+    {
+        const double l_nanoseconds = nanoseconds_per_call(
+            1,
+            [&](size_t)
+            {
+                std::ofstream l_file(l_path);
+
+                if (l_format == std::string_view("verilog"))
+                    write_verilog(l_file, { &l_majority, 1 }, "majority");
+                else
+                    write_blif(l_file, { &l_majority, 1 }, "majority");
+            }
+        );
+
+        std::cout
+            << "    majority of " << VARIABLES << ", " << l_format << ": "
+            << std::filesystem::file_size(l_path) << " bytes, " << l_nanoseconds / 1e6 << " ms" << std::endl;
+    }
+
+    std::filesystem::remove(l_path);
+
+}
+
+void benchmark_binary(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// At least half of 2000 variables, which
+    ///     has about a million nodes.
+    constexpr uint32_t VARIABLES = 2000;
+
+    std::vector<const node*> l_thresholds(VARIABLES / 2 + 1, ZERO);
+
+    l_thresholds[0] = ONE;
+
+    for (uint32_t i = VARIABLES; i-- > 0;)
+        for (uint32_t k = VARIABLES / 2; k > 0; k--)
+            l_thresholds[k] = l_nodes.emplace(i, l_thresholds[k], l_thresholds[k - 1]);
+
+    const node* l_majority = l_thresholds[VARIABLES / 2];
+
+    std::string l_bytes;
+
+    const double l_write_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::ostringstream l_ostream;
+            write_binary(l_ostream, { &l_majority, 1 });
+            l_bytes = l_ostream.str();
+        }
+    );
+
+    dag l_read_nodes;
+
+    global_node_sink::bind(&l_read_nodes);
+
+    const double l_read_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::istringstream l_istream(l_bytes);
+            std::vector<const node*> l_roots;
+            read_binary(l_istream, l_roots);
+        }
+    );
+
+    std::cout
+        << "    majority of " << VARIABLES << ", " << l_read_nodes.size() << " nodes: " << l_bytes.size() << " bytes, write "
+        << l_write_nanoseconds / 1e6 << " ms (" << l_bytes.size() / (l_write_nanoseconds / 1e3) << " MB/s), read "
+        << l_read_nanoseconds / 1e6 << " ms (" << l_bytes.size() / (l_read_nanoseconds / 1e3) << " MB/s)" << std::endl;
+
+}
+
+void benchmark_frozen_dag(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// At least half of 2000 variables, which
+    ///     has about a million nodes.
+    constexpr uint32_t VARIABLES = 2000;
+
+    std::vector<const node*> l_thresholds(VARIABLES / 2 + 1, ZERO);
+
+    l_thresholds[0] = ONE;
+
+    for (uint32_t i = VARIABLES; i-- > 0;)
+        for (uint32_t k = VARIABLES / 2; k > 0; k--)
+            l_thresholds[k] = l_nodes.emplace(i, l_thresholds[k], l_thresholds[k - 1]);
+
+    const node* l_majority = l_thresholds[VARIABLES / 2];
+
+    const std::string l_path = (std::filesystem::temp_directory_path() / "factor_benchmark_frozen_dag.bin").string();
+
+    const double l_write_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::ofstream l_file(l_path, std::ios::binary);
+            write_frozen(l_file, { &l_majority, 1 });
+        }
+    );
+
+    frozen_dag l_frozen;
+
+    const double l_open_nanoseconds = nanoseconds_per_call(
+        16,
+        [&](size_t)
+        {
+            l_frozen.open(l_path.c_str());
+        }
+    );
+
+    /// Random inputs, each word set with probability one half.
+    std::mt19937_64 l_random(0);
+
+    std::vector<std::array<uint64_t, (VARIABLES + 63) / 64>> l_inputs(1024);
+
+    for (auto& l_input : l_inputs)
+        for (uint64_t& l_word : l_input)
+            l_word = l_random();
+
+    size_t l_true = 0;
+
+    const double l_frozen_nanoseconds = nanoseconds_per_call(
+        l_inputs.size(),
+        [&](size_t i)
+        {
+            l_true += l_frozen.evaluate(0, l_inputs[i]);
+        }
+    );
+
+    const double l_dag_nanoseconds = nanoseconds_per_call(
+        l_inputs.size(),
+        [&](size_t i)
+        {
+            l_true += evaluate(l_majority, std::span<const uint64_t>(l_inputs[i]));
+        }
+    );
+
+    std::cout
+        << "    majority of " << VARIABLES << ": " << std::filesystem::file_size(l_path) << " bytes, write "
+        << l_write_nanoseconds / 1e6 << " ms, open " << l_open_nanoseconds / 1e3 << " us, evaluate "
+        << l_frozen_nanoseconds << " ns frozen, " << l_dag_nanoseconds << " ns in the dag ("
+        << l_true << " true)" << std::endl;
+
+    std::filesystem::remove(l_path);
+
+}
+
+void benchmark_checkpoint(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// At least half of 600 variables, built through
+    ///     the caches the checkpoint keeps.
+    constexpr uint32_t VARIABLES = 600;
+
+    std::map<std::set<const node*>, const node*> l_conjunctions;
+    std::map<std::set<const node*>, const node*> l_disjunctions;
+
+    std::vector<const node*> l_thresholds(VARIABLES / 2 + 1, ZERO);
+
+    l_thresholds[0] = ONE;
+
+    for (uint32_t i = VARIABLES; i-- > 0;)
+        for (uint32_t k = VARIABLES / 2; k > 0; k--)
+            l_thresholds[k] =
+                factor::join(
+                    l_disjunctions,
+                    ZERO,
+                    ONE,
+                    factor::join(l_conjunctions, ONE, ZERO, literal(i, true), l_thresholds[k]),
+                    factor::join(l_conjunctions, ONE, ZERO, literal(i, false), l_thresholds[k - 1])
+                );
+
+    const node* l_majority = l_thresholds[VARIABLES / 2];
+
+    const checkpoint_tables l_tables = { { &l_conjunctions, &l_disjunctions }, {} };
+
+    const std::string l_path = (std::filesystem::temp_directory_path() / "factor_benchmark_checkpoint.bin").string();
+
+    const double l_save_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            save_checkpoint(l_path.c_str(), l_nodes, { &l_majority, 1 }, l_tables);
+        }
+    );
+
+    dag l_restored_nodes;
+
+    global_node_sink::bind(&l_restored_nodes);
+
+    std::map<std::set<const node*>, const node*> l_restored_conjunctions;
+    std::map<std::set<const node*>, const node*> l_restored_disjunctions;
+
+    const double l_load_nanoseconds = nanoseconds_per_call(
+        1,
+        [&](size_t)
+        {
+            std::vector<const node*> l_roots;
+            load_checkpoint(l_path.c_str(), l_roots, { { &l_restored_conjunctions, &l_restored_disjunctions }, {} });
+        }
+    );
+
+    std::cout
+        << "    majority of " << VARIABLES << ", " << l_restored_nodes.size() << " nodes, "
+        << l_conjunctions.size() + l_disjunctions.size() << " table entries: "
+        << std::filesystem::file_size(l_path) << " bytes, save " << l_save_nanoseconds / 1e6 << " ms, load "
+        << l_load_nanoseconds / 1e6 << " ms" << std::endl;
+
+    std::filesystem::remove(l_path);
+
+}
+
+void benchmark_main(
+
+)
+{
+    BENCHMARK(benchmark_compiled_function);
+    BENCHMARK(benchmark_packed_evaluate);
+    BENCHMARK(benchmark_expand);
+    BENCHMARK(benchmark_from_truth_table);
+    BENCHMARK(benchmark_from_cubes);
+    BENCHMARK(benchmark_parse);
+    BENCHMARK(benchmark_load_expression);
+    BENCHMARK(benchmark_parse_lines);
+    BENCHMARK(benchmark_pla);
+    BENCHMARK(benchmark_conjoin_clauses);
+    BENCHMARK(benchmark_netlist);
+    BENCHMARK(benchmark_print_shared);
+    BENCHMARK(benchmark_expression_writer);
+    BENCHMARK(benchmark_write_dot);
+    BENCHMARK(benchmark_hdl);
+    BENCHMARK(benchmark_binary);
+    BENCHMARK(benchmark_frozen_dag);
+    BENCHMARK(benchmark_checkpoint);
+}
+
+#pragma endregion
+
+/// Parses a file of one expression per line across all
+///     hardware threads, printing each line's function
+///     in input order and each malformed line to stderr.
+int parse_lines_main(
+    const char* a_path
+)
+{
+    std::ifstream l_file(a_path, std::ios::binary);
+
+    if (!l_file)
+    {
+        std::cerr << "cannot open " << a_path << std::endl;
+        return 1;
+    }
+
+    const std::string l_text(std::istreambuf_iterator<char>(l_file), {});
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::vector<line_error> l_errors;
+
+    const std::vector<const node*> l_roots = parse_lines(l_text, l_errors);
+
+    for (const line_error& l_error : l_errors)
+        std::cerr
+            << a_path << ":" << l_error.m_line + 1 << ":" << l_error.m_error.m_position + 1 << ": "
+            << l_error.m_error.m_message << std::endl;
+
+    for (const node* l_root : l_roots)
+        std::cout << l_root << "\n";
+
+    return l_errors.empty() ? 0 : 1;
+
+}
+
+/// Reads the PLA in the argued file and writes
+///     a minimized cover of it to stdout.
+int pla_main(
+    const char* a_path
+)
+{
+    std::ifstream l_file(a_path, std::ios::binary);
+
+    if (!l_file)
+    {
+        std::cerr << "cannot open " << a_path << std::endl;
+        return 1;
+    }
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    pla l_pla;
+
+    if (const std::optional<line_error> l_error = read_pla(l_file, l_pla))
+    {
+        std::cerr
+            << a_path << ":" << l_error->m_line + 1 << ":" << l_error->m_error.m_position + 1 << ": "
+            << l_error->m_error.m_message << std::endl;
+        return 1;
+    }
+
+    write_pla(std::cout, l_pla);
+
+    return 0;
+
+}
+
+/// Compiles the DIMACS CNF file at the argued path,
+///     reporting the size of the result and the
+///     cost of constructing it.
+int cnf_main(
+    const char* a_path
+)
+{
+    std::ifstream l_file(a_path, std::ios::binary);
+
+    if (!l_file)
+    {
+        std::cerr << "cannot open " << a_path << std::endl;
+        return 1;
+    }
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    cnf l_cnf;
+
+    if (const std::optional<line_error> l_error = read_dimacs(l_file, l_cnf))
+    {
+        std::cerr
+            << a_path << ":" << l_error->m_line + 1 << ":" << l_error->m_error.m_position + 1 << ": "
+            << l_error->m_error.m_message << std::endl;
+        return 1;
+    }
+
+    conjunction_statistics l_statistics;
+
+    const node* l_product = conjoin_clauses(l_cnf, l_statistics);
+
+    std::cout
+        << l_cnf.m_variables << " variables, " << l_cnf.m_clauses.size() << " clauses: "
+        << (l_product == ZERO ? "unsatisfiable" : "satisfiable") << "\n"
+        << l_statistics.m_conjunctions << " conjunctions in " << l_statistics.m_elapsed.count() / 1e6 << " ms\n"
+        << l_statistics.m_peak_product_nodes << " peak product nodes, "
+        << l_statistics.m_dag_nodes << " dag nodes" << std::endl;
+
+    return 0;
+
+}
+
+/// Writes to the argued file a program holding generate_cpp's
+///     output for each bit of the product of two 8-bit operands,
+///     as tables where the support allows and all as expressions,
+///     together with random inputs and the bits evaluate gives
+///     for them. The program exits nonzero on any mismatch.
+int codegen_main(
+    const char* a_path
+)
+{
+    constexpr uint32_t OPERAND_BITS = 8;
+    constexpr size_t INPUTS = 1024;
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::list<const node*> l_x;
+    std::list<const node*> l_y;
+
+    for (uint32_t i = 0; i < OPERAND_BITS; i++)
+    {
+        l_x.push_back(literal(i, true));
+        l_y.push_back(literal(OPERAND_BITS + i, true));
+    }
+
+    const std::list<const node*> l_product_list = multiply(l_x, l_y);
+    const std::vector<const node*> l_product(l_product_list.begin(), l_product_list.end());
+
+    std::ofstream l_file(a_path);
+
+    if (!l_file)
+    {
+        std::cerr << "cannot write " << a_path << std::endl;
+        return 1;
+    }
+
+    l_file << "#include <stdio.h>\n\n";
+
+    for (size_t k = 0; k < l_product.size(); k++)
+    {
+        generate_cpp(l_file, l_product[k], "table_" + std::to_string(k));
+        l_file << "\n";
+        generate_cpp(l_file, l_product[k], "expression_" + std::to_string(k), 0);
+        l_file << "\n";
+    }
+
+    /// Bits above the operands are set too, and must be ignored.
+    std::mt19937_64 l_random(0);
+
+    std::vector<uint64_t> l_inputs(INPUTS);
+
+    for (uint64_t& l_input : l_inputs)
+        l_input = l_random();
+
+    l_file << "static const uint64_t INPUTS[" << INPUTS << "] = {\n";
+
+    for (uint64_t l_input : l_inputs)
+        l_file << "    " << l_input << "ULL,\n";
+
+    l_file << "};\n\nstatic const uint64_t EXPECTED[" << INPUTS << "] = {\n";
+
+    for (uint64_t l_input : l_inputs)
+    {
+        uint64_t l_expected = 0;
+
+        for (size_t k = 0; k < l_product.size(); k++)
+            l_expected |= uint64_t(evaluate(l_product[k], std::span<const uint64_t>(&l_input, 1))) << k;
+
+        l_file << "    " << l_expected << "ULL,\n";
+    }
+
+    l_file
+        << "};\n\n"
+        << "int main()\n"
+        << "{\n"
+        << "    int failures = 0;\n\n"
+        << "    for (int i = 0; i < " << INPUTS << "; i++)\n"
+        << "    {\n"
+        << "        uint64_t tables = 0;\n"
+        << "        uint64_t expressions = 0;\n\n";
+
+    for (size_t k = 0; k < l_product.size(); k++)
+        l_file
+            << "        tables |= uint64_t(table_" << k << "(&INPUTS[i])) << " << k << ";\n"
+            << "        expressions |= uint64_t(expression_" << k << "(&INPUTS[i])) << " << k << ";\n";
+
+    l_file
+        << "\n"
+        << "        if (tables != EXPECTED[i] || expressions != EXPECTED[i])\n"
+        << "        {\n"
+        << "            printf(\"input %d: expected %llx, tables gave %llx, expressions %llx\\n\", i,\n"
+        << "                (unsigned long long)EXPECTED[i], (unsigned long long)tables, (unsigned long long)expressions);\n"
+        << "            failures++;\n"
+        << "        }\n"
+        << "    }\n\n"
+        << "    printf(\"" << l_product.size() << " functions, " << INPUTS << " inputs, %d mismatches\\n\", failures);\n\n"
+        << "    return failures != 0;\n"
+        << "}\n";
+
+    return 0;
+
+}
+
+/// Writes the dag of the expression in the argued file to
+///     stdout as Graphviz, down to a_levels variables if given.
+int dot_main(
+    const char* a_path,
+    const char* a_levels
+)
+{
+    uint32_t l_levels = UINT32_MAX;
+
+    if (a_levels && std::from_chars(a_levels, a_levels + std::strlen(a_levels), l_levels).ec != std::errc())
+    {
+        std::cerr << "expected a level count, not " << a_levels << std::endl;
+        return 1;
+    }
+
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_root;
+
+    try
+    {
+        if (const std::optional<parse_error> l_error = load_expression(a_path, l_root))
+        {
+            std::cerr << a_path << ":" << l_error->m_position << ": " << l_error->m_message << std::endl;
+            return 1;
+        }
+    }
+    catch (const std::system_error& l_exception)
+    {
+        std::cerr << l_exception.what() << std::endl;
+        return 1;
+    }
+
+    write_dot(std::cout, { &l_root, 1 }, l_levels);
+
+    return 0;
+
+}
+
+int main(
+    int argc,
+    char** argv
 )
 {
-    unit_test_main();
+    if (argc > 1 && std::string_view(argv[1]) == "bench")
+        benchmark_main();
+    else if (argc > 2 && std::string_view(argv[1]) == "parse")
+        return parse_lines_main(argv[2]);
+    else if (argc > 2 && std::string_view(argv[1]) == "pla")
+        return pla_main(argv[2]);
+    else if (argc > 2 && std::string_view(argv[1]) == "cnf")
+        return cnf_main(argv[2]);
+    else if (argc > 2 && std::string_view(argv[1]) == "codegen")
+        return codegen_main(argv[2]);
+    else if (argc > 2 && std::string_view(argv[1]) == "dot")
+        return dot_main(argv[2], argc > 3 ? argv[3] : nullptr);
+    else
+        unit_test_main();
 }
@@ -0,0 +1,878 @@
+#include <assert.h>
+#include <algorithm>
+#include <charconv>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "include/netlist.h"
+
+namespace factor
+{
+    /// Orders the gates so that each follows the gates driving
+    ///     its fanins. Returns a gate on a cycle if there is one.
+    static std::optional<uint32_t> order_gates(
+        netlist& a_netlist
+    )
+    {
+        const uint32_t l_first_gate = a_netlist.m_inputs.size() + 1;
+
+        enum visit : uint8_t
+        {
+            UNVISITED,
+            VISITING,
+            VISITED,
+        };
+
+        std::vector<visit> l_visits(a_netlist.m_gates.size(), UNVISITED);
+
+        /// Gates being visited, with the index of
+        ///     the next fanin of each to visit.
+        std::vector<std::pair<uint32_t, uint32_t>> l_pending;
+
+        a_netlist.m_order.clear();
+        a_netlist.m_order.reserve(a_netlist.m_gates.size());
+
+        for (uint32_t l_root = 0; l_root < a_netlist.m_gates.size(); l_root++)
+        {
+            if (l_visits[l_root] != UNVISITED)
+                continue;
+
+            l_visits[l_root] = VISITING;
+            l_pending.push_back({ l_root, 0 });
+
+            while (!l_pending.empty())
+            {
+                const auto [l_gate, l_next_fanin] = l_pending.back();
+
+                const netlist::gate& l_definition = a_netlist.m_gates[l_gate];
+
+                if (l_next_fanin == l_definition.m_fanin_count)
+                {
+                    l_visits[l_gate] = VISITED;
+                    a_netlist.m_order.push_back(l_gate);
+                    l_pending.pop_back();
+                    continue;
+                }
+
+                l_pending.back().second++;
+
+                const uint32_t l_signal = a_netlist.m_fanins[l_definition.m_first_fanin + l_next_fanin] / 2;
+
+                if (l_signal < l_first_gate)
+                    continue;
+
+                const uint32_t l_fanin_gate = l_signal - l_first_gate;
+
+                if (l_visits[l_fanin_gate] == VISITING)
+                    return l_fanin_gate;
+
+                if (l_visits[l_fanin_gate] == UNVISITED)
+                {
+                    l_visits[l_fanin_gate] = VISITING;
+                    l_pending.push_back({ l_fanin_gate, 0 });
+                }
+
+            }
+        }
+
+        return std::nullopt;
+
+    }
+
+    ////////////////////////////////////////////
+    /////////////////// BLIF ///////////////////
+    ////////////////////////////////////////////
+
+    static constexpr uint32_t UNDRIVEN = UINT32_MAX;
+
+    struct blif_reader
+    {
+        netlist& m_netlist;
+
+        /// Maps each signal name to its index among the
+        ///     names, in order of first appearance.
+        std::unordered_map<std::string, uint32_t> m_names;
+
+        /// Defines, for each name, its input index, or its gate
+        ///     index offset by INPUT_LIMIT, or UNDRIVEN.
+        std::vector<uint32_t> m_drivers;
+
+        /// Defines, for each name, where it first appeared.
+        std::vector<std::pair<size_t, size_t>> m_first_uses;
+
+        /// Defines the outputs by name index.
+        std::vector<uint32_t> m_outputs;
+
+        /// Defines the line of each gate's .names.
+        std::vector<size_t> m_gate_lines;
+
+        /// Defines whether the rows read so far belong to the
+        ///     last gate, and whether their output column is set.
+        bool m_in_cover;
+        bool m_cover_phase_known;
+
+        bool m_ended;
+
+    };
+
+    /// Gate drivers are offset by this in blif_reader::m_drivers,
+    ///     distinguishing them from input drivers.
+    static constexpr uint32_t INPUT_LIMIT = UINT32_MAX / 2;
+
+    static std::optional<line_error> fail(
+        size_t a_line,
+        size_t a_position,
+        std::string_view a_message
+    )
+    {
+        return line_error{ a_line, { a_position, a_message } };
+    }
+
+    static uint32_t name_index(
+        blif_reader& a_reader,
+        std::string_view a_name,
+        size_t a_line_index,
+        size_t a_position
+    )
+    {
+        const auto [l_entry, l_inserted] = a_reader.m_names.try_emplace(std::string(a_name), a_reader.m_drivers.size());
+
+        if (l_inserted)
+        {
+            a_reader.m_drivers.push_back(UNDRIVEN);
+            a_reader.m_first_uses.push_back({ a_line_index, a_position });
+        }
+
+        return l_entry->second;
+
+    }
+
+    static std::optional<line_error> read_blif_directive(
+        blif_reader& a_reader,
+        std::string_view a_line,
+        size_t a_line_index
+    )
+    {
+        netlist& l_netlist = a_reader.m_netlist;
+
+        size_t l_position = 0;
+
+        const std::string_view l_keyword = next_word(a_line, l_position);
+
+        const auto l_position_of = [&](std::string_view a_word) { return size_t(a_word.data() - a_line.data()); };
+
+        a_reader.m_in_cover = false;
+
+        if (l_keyword == ".inputs")
+        {
+            for (std::string_view l_word = next_word(a_line, l_position); !l_word.empty(); l_word = next_word(a_line, l_position))
+            {
+                const uint32_t l_name = name_index(a_reader, l_word, a_line_index, l_position_of(l_word));
+
+                if (a_reader.m_drivers[l_name] != UNDRIVEN)
+                    return fail(a_line_index, l_position_of(l_word), "signal driven twice");
+
+                a_reader.m_drivers[l_name] = l_netlist.m_inputs.size();
+                l_netlist.m_inputs.emplace_back(l_word);
+            }
+
+            return std::nullopt;
+
+        }
+
+        if (l_keyword == ".outputs")
+        {
+            for (std::string_view l_word = next_word(a_line, l_position); !l_word.empty(); l_word = next_word(a_line, l_position))
+            {
+                a_reader.m_outputs.push_back(name_index(a_reader, l_word, a_line_index, l_position_of(l_word)));
+                l_netlist.m_output_names.emplace_back(l_word);
+            }
+
+            return std::nullopt;
+
+        }
+
+        if (l_keyword == ".names")
+        {
+            std::vector<std::string_view> l_words;
+
+            for (std::string_view l_word = next_word(a_line, l_position); !l_word.empty(); l_word = next_word(a_line, l_position))
+                l_words.push_back(l_word);
+
+            if (l_words.empty())
+                return fail(a_line_index, l_position, "expected an output name");
+
+            const uint32_t l_output = name_index(a_reader, l_words.back(), a_line_index, l_position_of(l_words.back()));
+
+            if (a_reader.m_drivers[l_output] != UNDRIVEN)
+                return fail(a_line_index, l_position_of(l_words.back()), "signal driven twice");
+
+            a_reader.m_drivers[l_output] = INPUT_LIMIT + l_netlist.m_gates.size();
+            a_reader.m_gate_lines.push_back(a_line_index);
+
+            /// Fanins hold name indices until the names are resolved.
+            l_netlist.m_gates.push_back({
+                uint32_t(l_netlist.m_fanins.size()),
+                uint32_t(l_words.size() - 1),
+                l_netlist.m_rows.size(),
+                0,
+                false
+            });
+
+            for (size_t i = 0; i + 1 < l_words.size(); i++)
+                l_netlist.m_fanins.push_back(name_index(a_reader, l_words[i], a_line_index, l_position_of(l_words[i])));
+
+            a_reader.m_in_cover = true;
+            a_reader.m_cover_phase_known = false;
+
+            return std::nullopt;
+
+        }
+
+        if (l_keyword == ".latch" || l_keyword == ".mlatch")
+            return fail(a_line_index, 0, "latches are not supported");
+
+        if (l_keyword == ".subckt" || l_keyword == ".gate" || l_keyword == ".search")
+            return fail(a_line_index, 0, "hierarchy is not supported");
+
+        /// The external don't-care network follows
+        ///     the model, and is not needed.
+        if (l_keyword == ".end" || l_keyword == ".exdc")
+            a_reader.m_ended = true;
+
+        /// .model and timing or area annotations
+        ///     do not affect the functions.
+        return std::nullopt;
+
+    }
+
+    static std::optional<line_error> read_blif_row(
+        blif_reader& a_reader,
+        std::string_view a_line,
+        size_t a_line_index
+    )
+    {
+        netlist& l_netlist = a_reader.m_netlist;
+
+        if (!a_reader.m_in_cover)
+            return fail(a_line_index, 0, "row outside a .names");
+
+        netlist::gate& l_gate = l_netlist.m_gates.back();
+
+        size_t l_position = 0;
+
+        /// A gate without fanins has only the output column.
+        const std::string_view l_plane = l_gate.m_fanin_count > 0 ? next_word(a_line, l_position) : std::string_view();
+        const std::string_view l_column = next_word(a_line, l_position);
+
+        const auto l_position_of = [&](std::string_view a_word) { return size_t(a_word.data() - a_line.data()); };
+
+        if (l_plane.size() != l_gate.m_fanin_count || l_plane.find_first_not_of("01-") != std::string_view::npos)
+            return fail(a_line_index, l_position_of(l_plane), "malformed row");
+
+        if (l_column != "0" && l_column != "1")
+            return fail(a_line_index, l_position_of(l_column), "expected an output value");
+
+        if (!next_word(a_line, l_position).empty())
+            return fail(a_line_index, l_position, "unexpected text after row");
+
+        const bool l_off_set = l_column == "0";
+
+        if (a_reader.m_cover_phase_known && l_off_set != l_gate.m_off_set)
+            return fail(a_line_index, l_position_of(l_column), "cover mixes on-set and off-set rows");
+
+        l_gate.m_off_set = l_off_set;
+        a_reader.m_cover_phase_known = true;
+
+        l_netlist.m_rows.append(l_plane);
+        l_gate.m_row_count++;
+
+        return std::nullopt;
+
+    }
+
+    std::optional<line_error> read_blif(
+        std::istream& a_istream,
+        netlist& a_netlist,
+        size_t a_buffer_bytes
+    )
+    {
+        a_netlist = netlist();
+
+        blif_reader l_reader{ a_netlist };
+
+        line_reader l_lines(a_istream, a_buffer_bytes);
+
+        /// A line continued with '\', and where it began.
+        std::string l_continued;
+        size_t l_continued_line = 0;
+
+        for (std::string_view l_line; !l_reader.m_ended && l_lines.next(l_line);)
+        {
+            size_t l_line_index = l_lines.lines() - 1;
+
+            l_line = l_line.substr(0, l_line.find('#'));
+
+            while (!l_line.empty() && is_blank(l_line.back()))
+                l_line.remove_suffix(1);
+
+            if (!l_line.empty() && l_line.back() == '\\')
+            {
+                if (l_continued.empty())
+                    l_continued_line = l_line_index;
+
+                l_continued.append(l_line.substr(0, l_line.size() - 1)).push_back(' ');
+
+                continue;
+
+            }
+
+            if (!l_continued.empty())
+            {
+                l_continued.append(l_line);
+                l_line = l_continued;
+                l_line_index = l_continued_line;
+            }
+
+            size_t l_position = 0;
+
+            const std::string_view l_first = next_word(l_line, l_position);
+
+            std::optional<line_error> l_error;
+
+            if (l_first.empty())
+                ;
+            else if (l_first[0] == '.')
+                l_error = read_blif_directive(l_reader, l_line, l_line_index);
+            else
+                l_error = read_blif_row(l_reader, l_line, l_line_index);
+
+            if (l_error)
+                return l_error;
+
+            l_continued.clear();
+
+        }
+
+        /// Resolve names to signals now that every
+        ///     input and gate is known.
+        const uint32_t l_first_gate = a_netlist.m_inputs.size() + 1;
+
+        std::vector<uint32_t> l_signals(l_reader.m_drivers.size());
+
+        for (size_t i = 0; i < l_signals.size(); i++)
+        {
+            const uint32_t l_driver = l_reader.m_drivers[i];
+
+            if (l_driver == UNDRIVEN)
+                return fail(l_reader.m_first_uses[i].first, l_reader.m_first_uses[i].second, "undriven signal");
+
+            l_signals[i] = l_driver >= INPUT_LIMIT ? l_first_gate + (l_driver - INPUT_LIMIT) : 1 + l_driver;
+        }
+
+        for (uint32_t& l_fanin : a_netlist.m_fanins)
+            l_fanin = 2 * l_signals[l_fanin];
+
+        for (uint32_t l_output : l_reader.m_outputs)
+            a_netlist.m_outputs.push_back(2 * l_signals[l_output]);
+
+        if (const std::optional<uint32_t> l_cyclic = order_gates(a_netlist))
+            return fail(l_reader.m_gate_lines[*l_cyclic], 0, "combinational cycle");
+
+        return std::nullopt;
+
+    }
+
+    ////////////////////////////////////////////
+    ////////////////// AIGER ///////////////////
+    ////////////////////////////////////////////
+
+    /// Reads bytes from a stream, tracking the offset.
+    struct aiger_reader
+    {
+        std::streambuf& m_buffer;
+        size_t m_offset;
+
+        int get(
+
+        )
+        {
+            const int l_char = m_buffer.sbumpc();
+
+            if (l_char != std::char_traits<char>::eof())
+                m_offset++;
+
+            return l_char;
+
+        }
+
+        /// Reads up to the next newline, returning false
+        ///     if the stream has ended.
+        bool line(
+            std::string& a_line
+        )
+        {
+            a_line.clear();
+
+            int l_char = get();
+
+            if (l_char == std::char_traits<char>::eof())
+                return false;
+
+            for (; l_char != std::char_traits<char>::eof() && l_char != '\n'; l_char = get())
+                a_line.push_back(char(l_char));
+
+            return true;
+
+        }
+
+    };
+
+    std::optional<parse_error> read_aiger(
+        std::istream& a_istream,
+        netlist& a_netlist
+    )
+    {
+        a_netlist = netlist();
+
+        aiger_reader l_reader{ *a_istream.rdbuf(), 0 };
+
+        std::string l_line;
+
+        /// Reads the unsigned numbers of a line, failing
+        ///     unless there are exactly as many as argued.
+        const auto l_numbers = [&](std::initializer_list<uint32_t*> a_numbers) -> std::optional<parse_error>
+        {
+            const size_t l_start = l_reader.m_offset;
+
+            if (!l_reader.line(l_line))
+                return parse_error{ l_start, "unexpected end of file" };
+
+            size_t l_position = 0;
+
+            for (uint32_t* l_number : a_numbers)
+            {
+                const std::string_view l_word = next_word(l_line, l_position);
+
+                const auto [l_next, l_error] = std::from_chars(l_word.data(), l_word.data() + l_word.size(), *l_number);
+
+                if (l_word.empty() || l_error != std::errc() || l_next != l_word.data() + l_word.size())
+                    return parse_error{ l_start + (l_word.data() - l_line.data()), "expected a number" };
+            }
+
+            if (!next_word(l_line, l_position).empty())
+                return parse_error{ l_start + l_position, "unexpected text" };
+
+            return std::nullopt;
+
+        };
+
+        /// The header, less the optional AIGER 1.9 counts of bad
+        ///     states, constraints, justice and fairness properties.
+        if (!l_reader.line(l_line))
+            return parse_error{ 0, "missing header" };
+
+        size_t l_position = 0;
+
+        const std::string_view l_format = next_word(l_line, l_position);
+
+        if (l_format != "aag" && l_format != "aig")
+            return parse_error{ 0, "expected \"aag\" or \"aig\"" };
+
+        const bool l_binary = l_format == "aig";
+
+        uint32_t l_header[5];
+
+        for (uint32_t& l_count : l_header)
+        {
+            const std::string_view l_word = next_word(l_line, l_position);
+
+            const auto [l_next, l_error] = std::from_chars(l_word.data(), l_word.data() + l_word.size(), l_count);
+
+            if (l_word.empty() || l_error != std::errc() || l_next != l_word.data() + l_word.size())
+                return parse_error{ size_t(l_word.data() - l_line.data()), "expected a number" };
+        }
+
+        for (std::string_view l_word = next_word(l_line, l_position); !l_word.empty(); l_word = next_word(l_line, l_position))
+            if (l_word != "0")
+                return parse_error{ size_t(l_word.data() - l_line.data()), "properties are not supported" };
+
+        const auto [l_maximum, l_input_count, l_latch_count, l_output_count, l_and_count] = l_header;
+
+        if (l_latch_count > 0)
+            return parse_error{ 0, "latches are not supported" };
+
+        if (size_t(l_input_count) + l_and_count > l_maximum)
+            return parse_error{ 0, "maximum variable index is too small" };
+
+        /// Maps AIGER variables to signals, and records
+        ///     where each gate was defined.
+        std::vector<uint32_t> l_signals(size_t(l_maximum) + 1, UNDRIVEN);
+        std::vector<size_t> l_gate_offsets(l_and_count);
+
+        l_signals[0] = 0;
+
+        const auto l_define = [&](uint32_t a_literal, uint32_t a_signal, size_t a_offset) -> std::optional<parse_error>
+        {
+            if (a_literal % 2 == 1 || a_literal < 2 || a_literal / 2 > l_maximum)
+                return parse_error{ a_offset, "malformed definition" };
+
+            if (l_signals[a_literal / 2] != UNDRIVEN)
+                return parse_error{ a_offset, "variable defined twice" };
+
+            l_signals[a_literal / 2] = a_signal;
+
+            return std::nullopt;
+
+        };
+
+        const uint32_t l_first_gate = l_input_count + 1;
+
+        a_netlist.m_inputs.resize(l_input_count);
+
+        for (uint32_t i = 0; i < l_input_count; i++)
+        {
+            uint32_t l_literal = 2 * (i + 1);
+
+            const size_t l_start = l_reader.m_offset;
+
+            if (!l_binary)
+                if (std::optional<parse_error> l_error = l_numbers({ &l_literal }))
+                    return l_error;
+
+            if (std::optional<parse_error> l_error = l_define(l_literal, 1 + i, l_start))
+                return l_error;
+        }
+
+        /// Literals are mapped to signals once every
+        ///     variable has been defined.
+        std::vector<size_t> l_output_offsets(l_output_count);
+
+        a_netlist.m_outputs.resize(l_output_count);
+        a_netlist.m_output_names.resize(l_output_count);
+
+        for (uint32_t i = 0; i < l_output_count; i++)
+        {
+            l_output_offsets[i] = l_reader.m_offset;
+
+            if (std::optional<parse_error> l_error = l_numbers({ &a_netlist.m_outputs[i] }))
+                return l_error;
+        }
+
+        a_netlist.m_gates.reserve(l_and_count);
+        a_netlist.m_fanins.resize(2 * size_t(l_and_count));
+
+        for (uint32_t i = 0; i < l_and_count; i++)
+        {
+            uint32_t l_lhs = 2 * (l_first_gate + i);
+            uint32_t& l_rhs0 = a_netlist.m_fanins[2 * i];
+            uint32_t& l_rhs1 = a_netlist.m_fanins[2 * i + 1];
+
+            l_gate_offsets[i] = l_reader.m_offset;
+
+            if (l_binary)
+            {
+                /// Each delta is a little-endian base-128 varint.
+                uint32_t l_deltas[2];
+
+                for (uint32_t& l_delta : l_deltas)
+                {
+                    l_delta = 0;
+
+                    for (uint32_t l_shift = 0;; l_shift += 7)
+                    {
+                        const int l_byte = l_reader.get();
+
+                        if (l_byte == std::char_traits<char>::eof())
+                            return parse_error{ l_reader.m_offset, "unexpected end of file" };
+
+                        if (l_shift > 28)
+                            return parse_error{ l_reader.m_offset - 1, "malformed delta" };
+
+                        l_delta |= uint32_t(l_byte & 0x7F) << l_shift;
+
+                        if ((l_byte & 0x80) == 0)
+                            break;
+                    }
+                }
+
+                if (l_deltas[0] > l_lhs || l_deltas[1] > l_lhs - l_deltas[0])
+                    return parse_error{ l_gate_offsets[i], "malformed delta" };
+
+                l_rhs0 = l_lhs - l_deltas[0];
+                l_rhs1 = l_rhs0 - l_deltas[1];
+            }
+            else if (std::optional<parse_error> l_error = l_numbers({ &l_lhs, &l_rhs0, &l_rhs1 }))
+                return l_error;
+
+            if (std::optional<parse_error> l_error = l_define(l_lhs, l_first_gate + i, l_gate_offsets[i]))
+                return l_error;
+
+            a_netlist.m_gates.push_back({ 2 * i, 2, 2 * size_t(i), 1, false });
+
+        }
+
+        a_netlist.m_rows.assign(2 * size_t(l_and_count), '1');
+
+        const auto l_map = [&](uint32_t& a_literal, size_t a_offset) -> std::optional<parse_error>
+        {
+            if (a_literal / 2 > l_maximum || l_signals[a_literal / 2] == UNDRIVEN)
+                return parse_error{ a_offset, "undefined literal" };
+
+            a_literal = 2 * l_signals[a_literal / 2] + a_literal % 2;
+
+            return std::nullopt;
+
+        };
+
+        for (uint32_t i = 0; i < l_output_count; i++)
+            if (std::optional<parse_error> l_error = l_map(a_netlist.m_outputs[i], l_output_offsets[i]))
+                return l_error;
+
+        for (uint32_t i = 0; i < l_and_count; i++)
+            for (uint32_t k = 0; k < 2; k++)
+                if (std::optional<parse_error> l_error = l_map(a_netlist.m_fanins[2 * i + k], l_gate_offsets[i]))
+                    return l_error;
+
+        /// The symbol table, which ends at a comment
+        ///     section or at the end of the file.
+        for (size_t l_start = l_reader.m_offset; l_reader.line(l_line) && !l_line.empty() && l_line[0] != 'c'; l_start = l_reader.m_offset)
+        {
+            const size_t l_space = l_line.find(' ');
+
+            uint32_t l_index = 0;
+
+            const auto [l_next, l_error] = std::from_chars(l_line.data() + 1, l_line.data() + std::min(l_space, l_line.size()), l_index);
+
+            if (l_space == std::string::npos || l_error != std::errc() || l_next != l_line.data() + l_space)
+                return parse_error{ l_start, "malformed symbol" };
+
+            std::vector<std::string>* l_names =
+                l_line[0] == 'i' ? &a_netlist.m_inputs :
+                l_line[0] == 'o' ? &a_netlist.m_output_names :
+                nullptr;
+
+            if (l_names == nullptr || l_index >= l_names->size())
+                return parse_error{ l_start, "malformed symbol" };
+
+            (*l_names)[l_index] = l_line.substr(l_space + 1);
+
+        }
+
+        if (const std::optional<uint32_t> l_cyclic = order_gates(a_netlist))
+            return parse_error{ l_gate_offsets[*l_cyclic], "combinational cycle" };
+
+        return std::nullopt;
+
+    }
+
+    ////////////////////////////////////////////
+    /////////// SYMBOLIC SIMULATION ////////////
+    ////////////////////////////////////////////
+
+    /// Builds the functions of the argued output literals into
+    ///     a private dag, returned in a_dag, compacting it as
+    ///     gate functions are released.
+    static std::vector<const node*> build_cones(
+        const netlist& a_netlist,
+        std::span<const uint32_t> a_outputs,
+        size_t a_compact_nodes,
+        std::unique_ptr<dag>& a_dag
+    )
+    {
+        const uint32_t l_first_gate = a_netlist.m_inputs.size() + 1;
+        const size_t l_signal_count = l_first_gate + a_netlist.m_gates.size();
+
+        /// Count the uses of each signal within the cones;
+        ///     gates outside them are never built.
+        std::vector<uint32_t> l_fanouts(l_signal_count, 0);
+
+        {
+            std::vector<uint32_t> l_pending;
+
+            const auto l_use = [&](uint32_t a_literal)
+            {
+                const uint32_t l_signal = a_literal / 2;
+
+                if (l_fanouts[l_signal]++ == 0 && l_signal >= l_first_gate)
+                    l_pending.push_back(l_signal - l_first_gate);
+            };
+
+            for (uint32_t l_output : a_outputs)
+                l_use(l_output);
+
+            while (!l_pending.empty())
+            {
+                const netlist::gate& l_gate = a_netlist.m_gates[l_pending.back()];
+
+                l_pending.pop_back();
+
+                for (uint32_t i = 0; i < l_gate.m_fanin_count; i++)
+                    l_use(a_netlist.m_fanins[l_gate.m_first_fanin + i]);
+            }
+        }
+
+        a_dag = std::make_unique<dag>();
+
+        global_node_sink::bind(a_dag.get());
+
+        /// The functions of the gates built and not yet
+        ///     released. Released functions are ZERO.
+        std::vector<const node*> l_functions(l_signal_count, ZERO);
+
+        const auto l_literal_function = [&](uint32_t a_literal)
+        {
+            const uint32_t l_signal = a_literal / 2;
+
+            const node* l_function =
+                l_signal == 0 ? ZERO :
+                l_signal < l_first_gate ? literal(l_signal - 1, true) :
+                l_functions[l_signal];
+
+            return a_literal % 2 ? logic::invert(l_function) : l_function;
+        };
+
+        /// Defines the gates built since the last compaction
+        ///     or live at it, and the dag's size after it.
+        std::vector<uint32_t> l_built;
+        size_t l_live_nodes = 0;
+
+        /// The fanins' functions for the current gate, and
+        ///     their inversions, computed on first use.
+        std::vector<const node*> l_operands;
+        std::vector<std::optional<const node*>> l_inverted_operands;
+
+        for (uint32_t l_gate_index : a_netlist.m_order)
+        {
+            const uint32_t l_signal = l_first_gate + l_gate_index;
+
+            if (l_fanouts[l_signal] == 0)
+                continue;
+
+            const netlist::gate& l_gate = a_netlist.m_gates[l_gate_index];
+
+            l_operands.clear();
+            l_inverted_operands.assign(l_gate.m_fanin_count, std::nullopt);
+
+            for (uint32_t i = 0; i < l_gate.m_fanin_count; i++)
+                l_operands.push_back(l_literal_function(a_netlist.m_fanins[l_gate.m_first_fanin + i]));
+
+            const auto l_inverted_operand = [&](uint32_t a_fanin)
+            {
+                if (!l_inverted_operands[a_fanin])
+                    l_inverted_operands[a_fanin] = logic::invert(l_operands[a_fanin]);
+
+                return *l_inverted_operands[a_fanin];
+            };
+
+            const node* l_sum = ZERO;
+
+            for (uint32_t l_row = 0; l_row < l_gate.m_row_count && l_sum != ONE; l_row++)
+            {
+                const char* l_plane = a_netlist.m_rows.data() + l_gate.m_first_row + size_t(l_row) * l_gate.m_fanin_count;
+
+                const node* l_product = ONE;
+
+                for (uint32_t i = 0; i < l_gate.m_fanin_count && l_product != ZERO; i++)
+                    if (l_plane[i] != '-')
+                        l_product = logic::conjoin(l_product, l_plane[i] == '1' ? l_operands[i] : l_inverted_operand(i));
+
+                l_sum = logic::disjoin(l_sum, l_product);
+
+            }
+
+            l_functions[l_signal] = l_gate.m_off_set ? logic::invert(l_sum) : l_sum;
+            l_built.push_back(l_signal);
+
+            /// Release each fanin whose last use this was.
+            for (uint32_t i = 0; i < l_gate.m_fanin_count; i++)
+            {
+                const uint32_t l_fanin = a_netlist.m_fanins[l_gate.m_first_fanin + i] / 2;
+
+                if (--l_fanouts[l_fanin] == 0)
+                    l_functions[l_fanin] = ZERO;
+            }
+
+            if (a_dag->size() > std::max(a_compact_nodes, 2 * l_live_nodes))
+            {
+                std::unique_ptr<dag> l_compacted = std::make_unique<dag>();
+
+                global_node_sink::bind(l_compacted.get());
+
+                std::map<const node*, const node*> l_cache;
+
+                std::erase_if(l_built, [&](uint32_t a_built) { return l_fanouts[a_built] == 0; });
+
+                for (uint32_t l_built_signal : l_built)
+                    l_functions[l_built_signal] = transplant(l_cache, l_functions[l_built_signal]);
+
+                a_dag = std::move(l_compacted);
+                l_live_nodes = a_dag->size();
+            }
+
+        }
+
+        std::vector<const node*> l_roots;
+
+        for (uint32_t l_output : a_outputs)
+            l_roots.push_back(l_literal_function(l_output));
+
+        return l_roots;
+
+    }
+
+    std::vector<const node*> build_outputs(
+        const netlist& a_netlist,
+        uint32_t a_threads,
+        size_t a_compact_nodes
+    )
+    {
+        const size_t l_output_count = a_netlist.m_outputs.size();
+
+        a_threads = std::max<uint32_t>(1, std::min<size_t>(a_threads, l_output_count));
+
+        std::vector<std::unique_ptr<dag>> l_thread_dags(a_threads);
+        std::vector<std::vector<const node*>> l_thread_roots(a_threads);
+
+        /// Each thread takes a contiguous run of the outputs,
+        ///     since neighbouring outputs tend to share logic.
+        const auto l_build = [&](uint32_t a_thread)
+        {
+            const size_t l_begin = l_output_count * a_thread / a_threads;
+            const size_t l_end = l_output_count * (a_thread + 1) / a_threads;
+
+            l_thread_roots[a_thread] = build_cones(
+                a_netlist,
+                std::span<const uint32_t>(a_netlist.m_outputs).subspan(l_begin, l_end - l_begin),
+                a_compact_nodes,
+                l_thread_dags[a_thread]
+            );
+        };
+
+        std::vector<std::thread> l_threads;
+
+        for (uint32_t i = 0; i < a_threads; i++)
+            l_threads.emplace_back(l_build, i);
+
+        for (std::thread& l_thread : l_threads)
+            l_thread.join();
+
+        std::vector<const node*> l_roots;
+
+        l_roots.reserve(l_output_count);
+
+        for (uint32_t i = 0; i < a_threads; i++)
+        {
+            std::map<const node*, const node*> l_cache;
+
+            for (const node* l_root : l_thread_roots[i])
+                l_roots.push_back(transplant(l_cache, l_root));
+        }
+
+        return l_roots;
+
+    }
+
+}
@@ -0,0 +1,1302 @@
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <map>
+#include <set>
+#include <system_error>
+#include <unordered_set>
+#include <vector>
+
+#include "include/parser.h"
+
+namespace factor
+{
+    token tokenizer::next(
+
+    )
+    {
+        while (m_position < m_text.size() && (m_text[m_position] == ' ' || m_text[m_position] == '\t' ||
+               m_text[m_position] == '\n' || m_text[m_position] == '\r'))
+            m_position++;
+
+        const size_t l_start = m_position;
+
+        if (m_position == m_text.size())
+            return { token::END, 0, l_start };
+
+        switch (m_text[m_position++])
+        {
+            case '\'': { return { token::PRIME, 0, l_start }; }
+            case '+' : { return { token::PLUS, 0, l_start }; }
+            case '(' : { return { token::OPEN, 0, l_start }; }
+            case ')' : { return { token::CLOSE, 0, l_start }; }
+            case '[' :
+            {
+                const char* l_end = m_text.data() + m_text.size();
+
+                uint32_t l_variable_index = 0;
+
+                const auto [l_next, l_error] = std::from_chars(
+                    m_text.data() + m_position,
+                    l_end,
+                    l_variable_index
+                );
+
+                if (l_error != std::errc() || l_next == l_end || *l_next != ']')
+                {
+                    m_position = l_next - m_text.data();
+                    return { token::INVALID, 0, l_start };
+                }
+
+                /// Step past the closing bracket.
+                m_position = l_next + 1 - m_text.data();
+
+                return { token::VARIABLE, l_variable_index, l_start };
+
+            }
+            case '$' :
+            {
+                uint32_t l_definition = 0;
+
+                const auto [l_next, l_error] = std::from_chars(
+                    m_text.data() + m_position,
+                    m_text.data() + m_text.size(),
+                    l_definition
+                );
+
+                m_position = l_next - m_text.data();
+
+                if (l_error != std::errc())
+                    return { token::INVALID, 0, l_start };
+
+                return { token::REFERENCE, l_definition, l_start };
+
+            }
+            default:
+            {
+                const auto l_is_name_start = [](char c) { return std::isalpha((unsigned char)c) || c == '_'; };
+                const auto l_is_name_char = [](char c) { return std::isalnum((unsigned char)c) || c == '_'; };
+
+                if (!l_is_name_start(m_text[l_start]))
+                    return { token::INVALID, 0, l_start };
+
+                while (m_position < m_text.size() && l_is_name_char(m_text[m_position]))
+                    m_position++;
+
+                /// An attached bit index belongs to the name.
+                if (m_position < m_text.size() && m_text[m_position] == '[')
+                {
+                    const size_t l_digits = m_position + 1;
+
+                    size_t l_end = l_digits;
+
+                    while (l_end < m_text.size() && std::isdigit((unsigned char)m_text[l_end]))
+                        l_end++;
+
+                    if (l_end == l_digits || l_end == m_text.size() || m_text[l_end] != ']')
+                    {
+                        m_position = l_end;
+                        return { token::INVALID, 0, l_start };
+                    }
+
+                    m_position = l_end + 1;
+                }
+
+                return { token::NAME, 0, l_start, m_text.substr(l_start, m_position - l_start) };
+
+            }
+        }
+
+    }
+
+    /// Marks a failed sub-parse; the error itself is
+    ///     recorded in the parser state.
+    static constexpr uint32_t FAILED = UINT32_MAX;
+
+    /// Hashes a vertex by its structure: its kind, variable
+    ///     and operands, which are themselves already unique.
+    struct vertex_hash
+    {
+        const ast* m_ast;
+
+        size_t operator()(
+            uint32_t a_vertex
+        ) const
+        {
+            const ast::vertex& l_vertex = m_ast->m_vertices[a_vertex];
+
+            size_t l_hash = l_vertex.m_kind * 0x9E3779B97F4A7C15ULL ^ l_vertex.m_variable_index;
+
+            for (uint32_t i = 0; i < l_vertex.m_count; i++)
+                l_hash = (l_hash ^ m_ast->m_operands[l_vertex.m_first + i]) * 0x100000001B3ULL;
+
+            return l_hash;
+
+        }
+
+    };
+
+    struct vertex_equal
+    {
+        const ast* m_ast;
+
+        bool operator()(
+            uint32_t a_x,
+            uint32_t a_y
+        ) const
+        {
+            const ast::vertex& l_x = m_ast->m_vertices[a_x];
+            const ast::vertex& l_y = m_ast->m_vertices[a_y];
+
+            return
+                l_x.m_kind == l_y.m_kind &&
+                l_x.m_variable_index == l_y.m_variable_index &&
+                l_x.m_count == l_y.m_count &&
+                std::equal(
+                    m_ast->m_operands.begin() + l_x.m_first,
+                    m_ast->m_operands.begin() + l_x.m_first + l_x.m_count,
+                    m_ast->m_operands.begin() + l_y.m_first
+                );
+
+        }
+
+    };
+
+    /// Appends to a_indices each index the argued text
+    ///     writes as "[i]", so that names new to the symbol
+    ///     table can be kept off them.
+    static void collect_indices(
+        std::string_view a_text,
+        std::vector<uint32_t>& a_indices
+    )
+    {
+        tokenizer l_tokenizer(a_text);
+
+        for (token l_token = l_tokenizer.next(); l_token.m_kind != token::END; l_token = l_tokenizer.next())
+            if (l_token.m_kind == token::VARIABLE)
+                a_indices.push_back(l_token.m_variable_index);
+
+    }
+
+    /// Sorts the argued indices and drops repeats, as
+    ///     symbol_table::intern expects of those it must skip.
+    static void normalize_indices(
+        std::vector<uint32_t>& a_indices
+    )
+    {
+        std::sort(a_indices.begin(), a_indices.end());
+        a_indices.erase(std::unique(a_indices.begin(), a_indices.end()), a_indices.end());
+    }
+
+    struct parser_state
+    {
+        std::string_view m_text;
+        tokenizer m_tokenizer;
+        token m_token;
+        ast& m_ast;
+        symbol_table& m_symbols;
+
+        /// Defines how many definitions a reference may name.
+        uint32_t m_definitions;
+
+        /// Operands of the products and sums being parsed,
+        ///     moved into the tree as each is completed.
+        std::vector<uint32_t> m_pending;
+
+        std::optional<parse_error> m_error;
+
+        /// Defines the vertices created so far, by structure.
+        std::unordered_set<uint32_t, vertex_hash, vertex_equal> m_interned;
+
+        /// Defines the indices the text writes as "[i]",
+        ///     ascending, which new names must not take.
+        std::vector<uint32_t> m_taken;
+
+    };
+
+    static uint32_t fail(
+        parser_state& a_state,
+        std::string_view a_message
+    )
+    {
+        a_state.m_error = parse_error{ a_state.m_token.m_position, a_message };
+        return FAILED;
+    }
+
+    /// Describes the error of meeting the argued token where it
+    ///     cannot appear, a_text being the text it was read from.
+    static std::string_view describe_unexpected(
+        const token& a_token,
+        std::string_view a_text
+    )
+    {
+        switch (a_token.m_kind)
+        {
+            case token::INVALID:
+            {
+                if (a_text[a_token.m_position] == '[')
+                    return "malformed variable, expected [<index>]";
+                if (a_text[a_token.m_position] == '$')
+                    return "malformed reference, expected $<index>";
+                if (std::isalpha((unsigned char)a_text[a_token.m_position]) || a_text[a_token.m_position] == '_')
+                    return "malformed name, expected <name> or <name>[<index>]";
+                return "unexpected character";
+            }
+            case token::REFERENCE: { return "undefined reference"; }
+            case token::PRIME: { return "inversion without an operand"; }
+            case token::CLOSE: { return "unmatched ')'"; }
+            default:           { return "unexpected token"; }
+        }
+    }
+
+    static uint32_t fail_on_token(
+        parser_state& a_state
+    )
+    {
+        return fail(a_state, describe_unexpected(a_state.m_token, a_state.m_text));
+    }
+
+    /// Creates a vertex over the operands last appended from
+    ///     a_first onward, unless a structurally identical one
+    ///     exists, in which case those operands are dropped and
+    ///     the existing vertex is returned.
+    static uint32_t add_vertex(
+        parser_state& a_state,
+        ast::vertex::kind a_kind,
+        uint32_t a_variable_index,
+        uint32_t a_first,
+        uint32_t a_count
+    )
+    {
+        ast& l_ast = a_state.m_ast;
+
+        l_ast.m_vertices.push_back({ a_kind, a_variable_index, a_first, a_count });
+
+        const auto [l_entry, l_inserted] = a_state.m_interned.insert(l_ast.m_vertices.size() - 1);
+
+        if (!l_inserted)
+        {
+            l_ast.m_vertices.pop_back();
+
+            if (a_count > 0)
+                l_ast.m_operands.resize(a_first);
+        }
+
+        return *l_entry;
+
+    }
+
+    /// Moves the pending operands from a_base onward into an
+    ///     n-ary vertex, or returns the lone operand itself.
+    static uint32_t reduce_pending(
+        parser_state& a_state,
+        ast::vertex::kind a_kind,
+        size_t a_base
+    )
+    {
+        const uint32_t l_count = a_state.m_pending.size() - a_base;
+
+        if (l_count == 1)
+        {
+            const uint32_t l_operand = a_state.m_pending.back();
+            a_state.m_pending.pop_back();
+            return l_operand;
+        }
+
+        const uint32_t l_first = a_state.m_ast.m_operands.size();
+
+        a_state.m_ast.m_operands.insert(
+            a_state.m_ast.m_operands.end(),
+            a_state.m_pending.begin() + a_base,
+            a_state.m_pending.end()
+        );
+
+        a_state.m_pending.resize(a_base);
+
+        return add_vertex(a_state, a_kind, 0, l_first, l_count);
+
+    }
+
+    static uint32_t parse_sum(
+        parser_state& a_state
+    );
+
+    static uint32_t parse_product(
+        parser_state& a_state
+    )
+    {
+        const size_t l_base = a_state.m_pending.size();
+
+        while (a_state.m_token.m_kind == token::VARIABLE || a_state.m_token.m_kind == token::NAME ||
+               a_state.m_token.m_kind == token::REFERENCE || a_state.m_token.m_kind == token::OPEN)
+        {
+            uint32_t l_factor;
+
+            if (a_state.m_token.m_kind == token::VARIABLE)
+            {
+                l_factor = add_vertex(a_state, ast::vertex::VARIABLE, a_state.m_token.m_variable_index, 0, 0);
+                a_state.m_token = a_state.m_tokenizer.next();
+            }
+            else if (a_state.m_token.m_kind == token::NAME)
+            {
+                l_factor = add_vertex(a_state, ast::vertex::VARIABLE, a_state.m_symbols.intern(a_state.m_token.m_name, a_state.m_taken), 0, 0);
+                a_state.m_token = a_state.m_tokenizer.next();
+            }
+            else if (a_state.m_token.m_kind == token::REFERENCE)
+            {
+                if (a_state.m_token.m_variable_index >= a_state.m_definitions)
+                    return fail_on_token(a_state);
+
+                l_factor = add_vertex(a_state, ast::vertex::REFERENCE, a_state.m_token.m_variable_index, 0, 0);
+                a_state.m_token = a_state.m_tokenizer.next();
+            }
+            else
+            {
+                const size_t l_open = a_state.m_token.m_position;
+
+                a_state.m_token = a_state.m_tokenizer.next();
+
+                l_factor = parse_sum(a_state);
+
+                if (l_factor == FAILED)
+                    return FAILED;
+
+                if (a_state.m_token.m_kind != token::CLOSE)
+                {
+                    /// Report the unclosed paren rather than
+                    ///     wherever the text happened to end.
+                    if (a_state.m_token.m_kind == token::END)
+                    {
+                        a_state.m_error = parse_error{ l_open, "unmatched '('" };
+                        return FAILED;
+                    }
+
+                    return fail_on_token(a_state);
+                }
+
+                a_state.m_token = a_state.m_tokenizer.next();
+            }
+
+            while (a_state.m_token.m_kind == token::PRIME)
+            {
+                const uint32_t l_operand = a_state.m_ast.m_operands.size();
+
+                a_state.m_ast.m_operands.push_back(l_factor);
+
+                l_factor = add_vertex(a_state, ast::vertex::INVERSION, 0, l_operand, 1);
+
+                a_state.m_token = a_state.m_tokenizer.next();
+            }
+
+            a_state.m_pending.push_back(l_factor);
+
+        }
+
+        /// The empty product is ONE.
+        if (a_state.m_pending.size() == l_base)
+            return add_vertex(a_state, ast::vertex::PRODUCT, 0, a_state.m_ast.m_operands.size(), 0);
+
+        return reduce_pending(a_state, ast::vertex::PRODUCT, l_base);
+
+    }
+
+    /// Parses terms separated by '+' iteratively, so long
+    ///     sums do not nest.
+    static uint32_t parse_sum(
+        parser_state& a_state
+    )
+    {
+        const size_t l_base = a_state.m_pending.size();
+
+        while (true)
+        {
+            const uint32_t l_term = parse_product(a_state);
+
+            if (l_term == FAILED)
+                return FAILED;
+
+            a_state.m_pending.push_back(l_term);
+
+            if (a_state.m_token.m_kind == token::PLUS)
+            {
+                a_state.m_token = a_state.m_tokenizer.next();
+                continue;
+            }
+
+            if (a_state.m_token.m_kind != token::CLOSE && a_state.m_token.m_kind != token::END)
+                return fail_on_token(a_state);
+
+            break;
+
+        }
+
+        return reduce_pending(a_state, ast::vertex::SUM, l_base);
+
+    }
+
+    /// Parses as the public parse does, but allows
+    ///     references to the first a_definitions definitions.
+    static std::optional<parse_error> parse(
+        std::string_view a_text,
+        ast& a_ast,
+        symbol_table& a_symbols,
+        uint32_t a_definitions
+    )
+    {
+        a_ast.m_vertices.clear();
+        a_ast.m_operands.clear();
+
+        parser_state l_state{
+            a_text,
+            tokenizer(a_text),
+            {},
+            a_ast,
+            a_symbols,
+            a_definitions,
+            {},
+            {},
+            std::unordered_set<uint32_t, vertex_hash, vertex_equal>(0, vertex_hash{ &a_ast }, vertex_equal{ &a_ast }),
+            {}
+        };
+
+        collect_indices(a_text, l_state.m_taken);
+        normalize_indices(l_state.m_taken);
+
+        l_state.m_token = l_state.m_tokenizer.next();
+
+        a_ast.m_root = parse_sum(l_state);
+
+        if (a_ast.m_root != FAILED && l_state.m_token.m_kind != token::END)
+            fail_on_token(l_state);
+
+        return l_state.m_error;
+
+    }
+
+    std::optional<parse_error> parse(
+        std::string_view a_text,
+        ast& a_ast,
+        symbol_table& a_symbols
+    )
+    {
+        return parse(a_text, a_ast, a_symbols, 0);
+    }
+
+    std::optional<parse_error> parse(
+        std::string_view a_text,
+        ast& a_ast
+    )
+    {
+        return parse(a_text, a_ast, global_node_sink::bound()->symbols());
+    }
+
+    struct build_state
+    {
+        const ast& m_ast;
+        std::span<const node* const> m_definitions;
+
+        /// Literals and built operands of the products and sums
+        ///     being built, each vertex using the entries above
+        ///     the size it found on entry.
+        std::vector<std::pair<uint32_t, bool>> m_literals;
+        std::vector<const node*> m_operands;
+
+        /// Defines the function of each vertex built so far,
+        ///     shared vertices being built only once.
+        std::vector<std::optional<const node*>> m_built;
+
+    };
+
+    /// Folds the functions from a_base onward from the right,
+    ///     as f + (g + (h + ...)), and pops them. Covers are
+    ///     commonly listed in variable order, and folding each
+    ///     term into the terms after it then only visits the
+    ///     new term's paths.
+    template<typename OPERATION>
+    static const node* reduce(
+        std::vector<const node*>& a_operands,
+        size_t a_base,
+        const node* a_identity,
+        const OPERATION& a_operation
+    )
+    {
+        if (a_operands.size() == a_base)
+            return a_identity;
+
+        const node* l_result = a_operands.back();
+
+        for (size_t i = a_operands.size() - 1; i-- > a_base;)
+            l_result = a_operation(a_operands[i], l_result);
+
+        a_operands.resize(a_base);
+
+        return l_result;
+
+    }
+
+    /// Disjoins two functions, emplacing directly when they
+    ///     split on the same variable with disjoint cofactors,
+    ///     as the printed form ([v]'f+[v]g) always does.
+    static const node* disjoin_operands(
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        if (a_x != ZERO && a_x != ONE && a_y != ZERO && a_y != ONE &&
+            a_x->depth() == a_y->depth())
+        {
+            if (a_x->positive() == ZERO && a_y->negative() == ZERO)
+                return global_node_sink::bound()->emplace(a_x->depth(), a_x->negative(), a_y->positive());
+
+            if (a_x->negative() == ZERO && a_y->positive() == ZERO)
+                return global_node_sink::bound()->emplace(a_x->depth(), a_y->negative(), a_x->positive());
+        }
+
+        return logic::disjoin(a_x, a_y);
+
+    }
+
+    /// Conjoins the literals and functions pushed from the argued
+    ///     bases onward, and pops them. Constant functions must
+    ///     already have been dropped or short-circuited.
+    static const node* conjoin_product(
+        std::vector<std::pair<uint32_t, bool>>& a_literals,
+        size_t a_literal_base,
+        std::vector<const node*>& a_operands,
+        size_t a_factor_base
+    )
+    {
+        const std::span<const std::pair<uint32_t, bool>> l_literals(
+            a_literals.data() + a_literal_base,
+            a_literals.size() - a_literal_base
+        );
+
+        const size_t l_factors = a_operands.size() - a_factor_base;
+
+        const node* l_cube = ONE;
+
+        if (!l_literals.empty())
+        {
+            /// A lone remaining factor lying wholly below the
+            ///     literals becomes the tail of the cube's chain.
+            if (l_factors == 1 &&
+                std::max_element(l_literals.begin(), l_literals.end())->first < a_operands.back()->depth())
+            {
+                l_cube = cube(l_literals, a_operands.back());
+                a_operands.pop_back();
+            }
+            else if (l_factors > 0)
+                a_operands.push_back(cube(l_literals));
+            else
+                l_cube = cube(l_literals);
+
+            a_literals.resize(a_literal_base);
+        }
+
+        if (a_operands.size() == a_factor_base)
+            return l_cube;
+
+        return reduce(
+            a_operands,
+            a_factor_base,
+            ONE,
+            [](const node* a_x, const node* a_y) { return logic::conjoin(a_x, a_y); }
+        );
+
+    }
+
+    static const node* build(
+        build_state& a_state,
+        uint32_t a_vertex
+    );
+
+    static const node* build_vertex(
+        build_state& a_state,
+        uint32_t a_vertex
+    )
+    {
+        const ast& l_ast = a_state.m_ast;
+        const ast::vertex& l_vertex = l_ast.m_vertices[a_vertex];
+
+        const std::span<const uint32_t> l_operands(
+            l_ast.m_operands.data() + l_vertex.m_first,
+            l_vertex.m_count
+        );
+
+        switch (l_vertex.m_kind)
+        {
+            case ast::vertex::VARIABLE:
+            {
+                return literal(l_vertex.m_variable_index, true);
+            }
+            case ast::vertex::REFERENCE:
+            {
+                return a_state.m_definitions[l_vertex.m_variable_index];
+            }
+            case ast::vertex::INVERSION:
+            {
+                const ast::vertex& l_operand = l_ast.m_vertices[l_operands.front()];
+
+                if (l_operand.m_kind == ast::vertex::VARIABLE)
+                    return literal(l_operand.m_variable_index, false);
+
+                return logic::invert(build(a_state, l_operands.front()));
+
+            }
+            case ast::vertex::PRODUCT:
+            {
+                const size_t l_literal_base = a_state.m_literals.size();
+                const size_t l_factor_base = a_state.m_operands.size();
+
+                const auto l_discard = [&]
+                {
+                    a_state.m_literals.resize(l_literal_base);
+                    a_state.m_operands.resize(l_factor_base);
+                    return ZERO;
+                };
+
+                /// Literal operands are gathered into a cube.
+                for (uint32_t l_operand : l_operands)
+                {
+                    const ast::vertex& l_factor = l_ast.m_vertices[l_operand];
+
+                    if (l_factor.m_kind == ast::vertex::VARIABLE)
+                    {
+                        a_state.m_literals.emplace_back(l_factor.m_variable_index, true);
+                        continue;
+                    }
+
+                    if (l_factor.m_kind == ast::vertex::INVERSION &&
+                        l_ast.m_vertices[l_ast.m_operands[l_factor.m_first]].m_kind == ast::vertex::VARIABLE)
+                    {
+                        a_state.m_literals.emplace_back(l_ast.m_vertices[l_ast.m_operands[l_factor.m_first]].m_variable_index, false);
+                        continue;
+                    }
+
+                    const node* l_built = build(a_state, l_operand);
+
+                    if (l_built == ZERO)
+                        return l_discard();
+
+                    if (l_built != ONE)
+                        a_state.m_operands.push_back(l_built);
+
+                }
+
+                return conjoin_product(a_state.m_literals, l_literal_base, a_state.m_operands, l_factor_base);
+
+            }
+            case ast::vertex::SUM:
+            {
+                const size_t l_term_base = a_state.m_operands.size();
+
+                for (uint32_t l_operand : l_operands)
+                {
+                    const node* l_built = build(a_state, l_operand);
+
+                    if (l_built == ONE)
+                    {
+                        a_state.m_operands.resize(l_term_base);
+                        return ONE;
+                    }
+
+                    if (l_built != ZERO)
+                        a_state.m_operands.push_back(l_built);
+
+                }
+
+                return reduce(a_state.m_operands, l_term_base, ZERO, disjoin_operands);
+
+            }
+        }
+
+        assert(false);
+        return ZERO;
+
+    }
+
+    static const node* build(
+        build_state& a_state,
+        uint32_t a_vertex
+    )
+    {
+        std::optional<const node*>& l_built = a_state.m_built[a_vertex];
+
+        if (!l_built)
+            l_built = build_vertex(a_state, a_vertex);
+
+        return *l_built;
+
+    }
+
+    const node* build(
+        const ast& a_ast,
+        std::span<const node* const> a_definitions
+    )
+    {
+        build_state l_state{ a_ast, a_definitions, {}, {}, std::vector<std::optional<const node*>>(a_ast.m_vertices.size()) };
+
+        return build(l_state, a_ast.m_root);
+    }
+
+    struct load_frame
+    {
+        /// Defines the file offset of the group's '('.
+        size_t m_open;
+
+        /// Defines where the group's closed terms, and then its
+        ///     current product, begin on the operand stack, and
+        ///     where that product's literals begin.
+        size_t m_term_base;
+        size_t m_factor_base;
+        size_t m_literal_base;
+
+    };
+
+    struct load_state
+    {
+        /// Defines the groups still open, outermost first,
+        ///     the whole text being the outermost group.
+        std::vector<load_frame> m_frames;
+
+        /// Literals and functions of the open products.
+        std::vector<std::pair<uint32_t, bool>> m_literals;
+        std::vector<const node*> m_operands;
+
+        /// Defines what the last token completed, which
+        ///     a following "'" inverts.
+        enum : uint8_t
+        {
+            NOTHING,
+            LITERAL,
+            GROUP,
+        } m_last;
+
+        /// Defines the indices the file writes as "[i]",
+        ///     ascending, which new names must not take.
+        std::vector<uint32_t> m_taken;
+
+    };
+
+    /// Defines how many closed terms a group holds before they
+    ///     are disjoined, bounding the operand stack for long sums.
+    static constexpr size_t LOAD_TERM_BATCH = 4096;
+
+    /// Closes the current product of the innermost group,
+    ///     leaving it on the operand stack as a term.
+    static void close_term(
+        load_state& a_state
+    )
+    {
+        load_frame& l_frame = a_state.m_frames.back();
+
+        const auto l_factors = a_state.m_operands.begin() + l_frame.m_factor_base;
+
+        const node* l_term;
+
+        if (std::find(l_factors, a_state.m_operands.end(), ZERO) != a_state.m_operands.end())
+        {
+            a_state.m_literals.resize(l_frame.m_literal_base);
+            a_state.m_operands.resize(l_frame.m_factor_base);
+            l_term = ZERO;
+        }
+        else
+        {
+            a_state.m_operands.erase(std::remove(l_factors, a_state.m_operands.end(), ONE), a_state.m_operands.end());
+            l_term = conjoin_product(a_state.m_literals, l_frame.m_literal_base, a_state.m_operands, l_frame.m_factor_base);
+        }
+
+        a_state.m_operands.push_back(l_term);
+
+        if (a_state.m_operands.size() - l_frame.m_term_base >= LOAD_TERM_BATCH)
+            a_state.m_operands.push_back(reduce(a_state.m_operands, l_frame.m_term_base, ZERO, disjoin_operands));
+
+        l_frame.m_factor_base = a_state.m_operands.size();
+
+    }
+
+    /// Closes the innermost group, returning its sum.
+    static const node* close_group(
+        load_state& a_state
+    )
+    {
+        close_term(a_state);
+
+        const size_t l_term_base = a_state.m_frames.back().m_term_base;
+
+        a_state.m_frames.pop_back();
+
+        return reduce(a_state.m_operands, l_term_base, ZERO, disjoin_operands);
+
+    }
+
+    static std::optional<parse_error> load_token(
+        load_state& a_state,
+        const token& a_token,
+        std::string_view a_text,
+        size_t a_offset
+    )
+    {
+        const size_t l_position = a_offset + a_token.m_position;
+
+        switch (a_token.m_kind)
+        {
+            case token::VARIABLE:
+            {
+                a_state.m_literals.emplace_back(a_token.m_variable_index, true);
+                a_state.m_last = load_state::LITERAL;
+                break;
+            }
+            case token::NAME:
+            {
+                a_state.m_literals.emplace_back(global_node_sink::bound()->symbols().intern(a_token.m_name, a_state.m_taken), true);
+                a_state.m_last = load_state::LITERAL;
+                break;
+            }
+            case token::PRIME:
+            {
+                if (a_state.m_last == load_state::LITERAL)
+                    a_state.m_literals.back().second = !a_state.m_literals.back().second;
+                else if (a_state.m_last == load_state::GROUP)
+                    a_state.m_operands.back() = logic::invert(a_state.m_operands.back());
+                else
+                    return parse_error{ l_position, describe_unexpected(a_token, a_text) };
+                break;
+            }
+            case token::OPEN:
+            {
+                a_state.m_frames.push_back({ l_position, a_state.m_operands.size(), a_state.m_operands.size(), a_state.m_literals.size() });
+                a_state.m_last = load_state::NOTHING;
+                break;
+            }
+            case token::PLUS:
+            {
+                close_term(a_state);
+                a_state.m_last = load_state::NOTHING;
+                break;
+            }
+            case token::CLOSE:
+            {
+                if (a_state.m_frames.size() == 1)
+                    return parse_error{ l_position, describe_unexpected(a_token, a_text) };
+
+                const node* l_group = close_group(a_state);
+
+                a_state.m_operands.push_back(l_group);
+                a_state.m_last = load_state::GROUP;
+                break;
+            }
+            default:
+            {
+                return parse_error{ l_position, describe_unexpected(a_token, a_text) };
+            }
+        }
+
+        return std::nullopt;
+
+    }
+
+    /// Maps the argued file a_chunk_bytes at a time and hands each
+    ///     token to a_visit, with the window it was read from and the
+    ///     window's offset in the file, stopping at the first error
+    ///     a_visit returns. Closes the file and throws
+    ///     std::system_error if a window cannot be mapped.
+    template<typename VISIT>
+    static std::optional<parse_error> scan_tokens(
+        int a_file,
+        const char* a_path,
+        size_t a_size,
+        size_t a_chunk_bytes,
+        VISIT&& a_visit
+    )
+    {
+        const size_t l_page = sysconf(_SC_PAGESIZE);
+
+        /// Windows begin on a page boundary at or before the first
+        ///     unread byte, so spanning two pages leaves at least
+        ///     one page of text in each.
+        size_t l_chunk = std::max((a_chunk_bytes + l_page - 1) / l_page * l_page, 2 * l_page);
+
+        std::optional<parse_error> l_error;
+
+        size_t l_offset = 0;
+
+        while (l_offset < a_size && !l_error)
+        {
+            const size_t l_map_offset = l_offset / l_page * l_page;
+            const size_t l_map_size = std::min(l_chunk, a_size - l_map_offset);
+
+            void* l_map = mmap(nullptr, l_map_size, PROT_READ, MAP_PRIVATE, a_file, l_map_offset);
+
+            if (l_map == MAP_FAILED)
+            {
+                const int l_errno = errno;
+                close(a_file);
+                throw std::system_error(l_errno, std::generic_category(), a_path);
+            }
+
+            madvise(l_map, l_map_size, MADV_SEQUENTIAL);
+
+            const std::string_view l_window(
+                static_cast<const char*>(l_map) + (l_offset - l_map_offset),
+                l_map_size - (l_offset - l_map_offset)
+            );
+
+            const bool l_last_window = l_map_offset + l_map_size == a_size;
+
+            tokenizer l_tokenizer(l_window);
+
+            size_t l_consumed = l_window.size();
+
+            for (token l_token = l_tokenizer.next(); l_token.m_kind != token::END; l_token = l_tokenizer.next())
+            {
+                /// A token reaching the end of the window may have
+                ///     been cut off, so is read again at the start of
+                ///     the next, which is made larger if the token
+                ///     spanned this whole window.
+                if (!l_last_window && l_tokenizer.position() == l_window.size())
+                {
+                    if (l_token.m_position == 0)
+                        l_chunk *= 2;
+
+                    l_consumed = l_token.m_position;
+                    break;
+                }
+
+                l_error = a_visit(l_token, l_window, l_offset);
+
+                if (l_error)
+                    break;
+
+            }
+
+            munmap(l_map, l_map_size);
+
+            l_offset += l_consumed;
+
+        }
+
+        return l_error;
+
+    }
+
+    std::optional<parse_error> load_expression(
+        const char* a_path,
+        const node*& a_node,
+        size_t a_chunk_bytes
+    )
+    {
+        const int l_file = open(a_path, O_RDONLY);
+
+        if (l_file < 0)
+            throw std::system_error(errno, std::generic_category(), a_path);
+
+        struct stat l_stat;
+
+        if (fstat(l_file, &l_stat) != 0)
+        {
+            const int l_errno = errno;
+            close(l_file);
+            throw std::system_error(l_errno, std::generic_category(), a_path);
+        }
+
+        const size_t l_size = l_stat.st_size;
+
+        /// A first pass finds the indices written as "[i]" anywhere
+        ///     in the file, which new names must not take.
+        std::set<uint32_t> l_written;
+
+        scan_tokens(l_file, a_path, l_size, a_chunk_bytes,
+            [&](const token& a_token, std::string_view, size_t) -> std::optional<parse_error>
+            {
+                if (a_token.m_kind == token::VARIABLE)
+                    l_written.insert(a_token.m_variable_index);
+                return std::nullopt;
+            });
+
+        load_state l_state{ { { 0, 0, 0, 0 } }, {}, {}, load_state::NOTHING, { l_written.begin(), l_written.end() } };
+
+        const std::optional<parse_error> l_error = scan_tokens(l_file, a_path, l_size, a_chunk_bytes,
+            [&](const token& a_token, std::string_view a_window, size_t a_offset)
+            {
+                return load_token(l_state, a_token, a_window, a_offset);
+            });
+
+        close(l_file);
+
+        if (l_error)
+            return l_error;
+
+        if (l_state.m_frames.size() > 1)
+            return parse_error{ l_state.m_frames.back().m_open, "unmatched '('" };
+
+        /// The empty text is the empty product.
+        a_node = close_group(l_state);
+
+        return std::nullopt;
+
+    }
+
+
+    bool line_reader::next(
+        std::string_view& a_line
+    )
+    {
+        if (m_partial_returned)
+        {
+            m_partial.clear();
+            m_partial_returned = false;
+        }
+
+        while (true)
+        {
+            const size_t l_end = m_block.find('\n');
+
+            if (l_end != std::string_view::npos)
+            {
+                a_line = m_block.substr(0, l_end);
+                m_block.remove_prefix(l_end + 1);
+
+                if (!m_partial.empty())
+                {
+                    m_partial.append(a_line);
+                    a_line = m_partial;
+                    m_partial_returned = true;
+                }
+
+                m_lines++;
+
+                return true;
+
+            }
+
+            m_partial.append(m_block);
+
+            m_istream.read(m_buffer.data(), m_buffer.size());
+
+            m_block = std::string_view(m_buffer.data(), m_istream.gcount());
+
+            if (m_block.empty())
+                break;
+
+        }
+
+        if (m_partial.empty())
+            return false;
+
+        a_line = m_partial;
+        m_partial_returned = true;
+        m_lines++;
+
+        return true;
+
+    }
+
+    /// Defines how many consecutive lines a thread
+    ///     takes from the batch at once.
+    static constexpr size_t PARSE_LINES_BLOCK = 64;
+
+    std::vector<const node*> parse_lines(
+        std::string_view a_text,
+        std::vector<line_error>& a_errors,
+        uint32_t a_threads
+    )
+    {
+        std::vector<std::string_view> l_lines;
+
+        for (size_t l_begin = 0; l_begin < a_text.size();)
+        {
+            const size_t l_end = std::min(a_text.find('\n', l_begin), a_text.size());
+
+            l_lines.push_back(a_text.substr(l_begin, l_end - l_begin));
+
+            l_begin = l_end + 1;
+
+        }
+
+        std::vector<const node*> l_roots(l_lines.size(), ZERO);
+
+        a_threads = std::max<uint32_t>(1, std::min<size_t>(a_threads, (l_lines.size() + PARSE_LINES_BLOCK - 1) / PARSE_LINES_BLOCK));
+
+        std::vector<dag> l_thread_dags(a_threads);
+        std::vector<std::vector<line_error>> l_thread_errors(a_threads);
+
+        /// Remember which thread built each line.
+        std::vector<uint32_t> l_builders(l_lines.size());
+
+        std::atomic<size_t> l_next_block = 0;
+
+        /// Names resolve to the same indices on every thread.
+        symbol_table& l_symbols = global_node_sink::bound()->symbols();
+
+        /// New names are interned here, in line order, so that their
+        ///     indices do not depend on which thread reaches them
+        ///     first; the threads then only look them up.
+        {
+            std::vector<uint32_t> l_taken;
+            std::vector<std::string_view> l_names;
+
+            for (std::string_view l_line : l_lines)
+            {
+                l_taken.clear();
+                l_names.clear();
+
+                tokenizer l_tokenizer(l_line);
+
+                for (token l_token = l_tokenizer.next(); l_token.m_kind != token::END; l_token = l_tokenizer.next())
+                {
+                    if (l_token.m_kind == token::VARIABLE)
+                        l_taken.push_back(l_token.m_variable_index);
+                    else if (l_token.m_kind == token::NAME)
+                        l_names.push_back(l_token.m_name);
+                }
+
+                normalize_indices(l_taken);
+
+                for (std::string_view l_name : l_names)
+                    l_symbols.intern(l_name, l_taken);
+
+            }
+        }
+
+        const auto l_parse_blocks = [&](uint32_t a_thread)
+        {
+            global_node_sink::bind(&l_thread_dags[a_thread]);
+
+            ast l_ast;
+
+            for (size_t l_first = l_next_block++ * PARSE_LINES_BLOCK; l_first < l_lines.size();
+                 l_first = l_next_block++ * PARSE_LINES_BLOCK)
+            {
+                for (size_t i = l_first; i < std::min(l_first + PARSE_LINES_BLOCK, l_lines.size()); i++)
+                {
+                    l_builders[i] = a_thread;
+
+                    if (const std::optional<parse_error> l_error = parse(l_lines[i], l_ast, l_symbols))
+                        l_thread_errors[a_thread].push_back({ i, *l_error });
+                    else
+                        l_roots[i] = build(l_ast);
+                }
+            }
+        };
+
+        std::vector<std::thread> l_threads;
+
+        for (uint32_t i = 0; i < a_threads; i++)
+            l_threads.emplace_back(l_parse_blocks, i);
+
+        for (std::thread& l_thread : l_threads)
+            l_thread.join();
+
+        /// Move the roots into the bound dag, memoizing
+        ///     per source dag.
+        std::vector<std::map<const node*, const node*>> l_caches(a_threads);
+
+        for (size_t i = 0; i < l_roots.size(); i++)
+            l_roots[i] = transplant(l_caches[l_builders[i]], l_roots[i]);
+
+        const size_t l_first_error = a_errors.size();
+
+        for (const std::vector<line_error>& l_errors : l_thread_errors)
+            a_errors.insert(a_errors.end(), l_errors.begin(), l_errors.end());
+
+        std::sort(
+            a_errors.begin() + l_first_error,
+            a_errors.end(),
+            [](const line_error& a_x, const line_error& a_y)
+            {
+                return a_x.m_line < a_y.m_line;
+            }
+        );
+
+        return l_roots;
+
+    }
+
+    static std::optional<line_error> fail(
+        size_t a_line,
+        size_t a_position,
+        std::string_view a_message
+    )
+    {
+        return line_error{ a_line, { a_position, a_message } };
+    }
+
+    std::optional<line_error> read_shared(
+        std::istream& a_istream,
+        const node*& a_node,
+        size_t a_buffer_bytes
+    )
+    {
+        line_reader l_lines(a_istream, a_buffer_bytes);
+
+        symbol_table& l_symbols = global_node_sink::bound()->symbols();
+
+        std::vector<const node*> l_definitions;
+
+        ast l_ast;
+
+        bool l_read = false;
+
+        for (std::string_view l_line; l_lines.next(l_line);)
+        {
+            const size_t l_line_index = l_lines.lines() - 1;
+
+            tokenizer l_tokenizer(l_line);
+
+            const token l_first = l_tokenizer.next();
+
+            if (l_first.m_kind == token::END)
+                continue;
+
+            if (l_read)
+                return fail(l_line_index, l_first.m_position, "text after the function");
+
+            /// A definition is a reference followed by '='.
+            size_t l_offset = l_tokenizer.position();
+
+            while (l_offset < l_line.size() && is_blank(l_line[l_offset]))
+                l_offset++;
+
+            const bool l_definition = l_first.m_kind == token::REFERENCE && l_offset < l_line.size() && l_line[l_offset] == '=';
+
+            if (l_definition)
+            {
+                if (l_first.m_variable_index != l_definitions.size())
+                    return fail(l_line_index, l_first.m_position, "definitions must be numbered in turn");
+
+                l_offset++;
+            }
+            else
+                l_offset = 0;
+
+            if (std::optional<parse_error> l_error = parse(l_line.substr(l_offset), l_ast, l_symbols, l_definitions.size()))
+                return fail(l_line_index, l_offset + l_error->m_position, l_error->m_message);
+
+            const node* l_built = build(l_ast, l_definitions);
+
+            if (l_definition)
+                l_definitions.push_back(l_built);
+            else
+            {
+                a_node = l_built;
+                l_read = true;
+            }
+
+        }
+
+        if (!l_read)
+            return fail(l_lines.lines(), 0, "missing function");
+
+        return std::nullopt;
+
+    }
+
+}
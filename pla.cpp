@@ -0,0 +1,674 @@
+#include <assert.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "include/pla.h"
+#include "include/cover.h"
+#include "include/minimize.h"
+
+namespace factor
+{
+    /// The sets a cube may place an output's minterms in.
+    enum pla_set : uint8_t
+    {
+        PLA_ON,
+        PLA_DONT_CARE,
+        PLA_OFF,
+    };
+
+    struct pla_reader
+    {
+        pla& m_pla;
+
+        bool m_inputs_given;
+        bool m_outputs_given;
+        bool m_ended;
+
+        /// Defines whether the cubes specify each set, by .type.
+        std::array<bool, 3> m_specified;
+
+        /// Defines the input planes of the cubes read
+        ///     so far, m_pla.m_inputs characters each.
+        std::string m_planes;
+        uint32_t m_cubes;
+
+        /// Defines, for each output, the cubes placed in each set.
+        std::vector<std::array<std::vector<uint32_t>, 3>> m_sets;
+
+        /// Defines the current cube with whitespace removed.
+        std::string m_cube;
+
+    };
+
+    static std::optional<line_error> fail(
+        size_t a_line,
+        size_t a_position,
+        std::string_view a_message
+    )
+    {
+        return line_error{ a_line, { a_position, a_message } };
+    }
+
+    static std::optional<line_error> read_count(
+        std::string_view a_line,
+        size_t a_line_index,
+        size_t& a_position,
+        uint32_t& a_count
+    )
+    {
+        const std::string_view l_word = next_word(a_line, a_position);
+
+        const auto [l_next, l_error] = std::from_chars(l_word.data(), l_word.data() + l_word.size(), a_count);
+
+        if (l_word.empty() || l_error != std::errc() || l_next != l_word.data() + l_word.size())
+            return fail(a_line_index, l_word.data() - a_line.data(), "expected a count");
+
+        return std::nullopt;
+
+    }
+
+    static std::optional<line_error> read_labels(
+        std::string_view a_line,
+        size_t a_line_index,
+        size_t a_position,
+        bool a_count_given,
+        uint32_t a_count,
+        std::vector<std::string>& a_labels
+    )
+    {
+        if (!a_count_given)
+            return fail(a_line_index, 0, "labels precede their count");
+
+        a_labels.clear();
+
+        for (std::string_view l_word = next_word(a_line, a_position); !l_word.empty(); l_word = next_word(a_line, a_position))
+            a_labels.emplace_back(l_word);
+
+        if (a_labels.size() != a_count)
+            return fail(a_line_index, a_position, "label count differs from the declared count");
+
+        return std::nullopt;
+
+    }
+
+    static std::optional<line_error> read_directive(
+        pla_reader& a_reader,
+        std::string_view a_line,
+        size_t a_line_index
+    )
+    {
+        pla& l_pla = a_reader.m_pla;
+
+        size_t l_position = 0;
+
+        const std::string_view l_keyword = next_word(a_line, l_position);
+
+        if ((l_keyword == ".i" || l_keyword == ".o") && a_reader.m_cubes > 0)
+            return fail(a_line_index, 0, "dimension declared after the first cube");
+
+        if (l_keyword == ".i")
+        {
+            a_reader.m_inputs_given = true;
+            return read_count(a_line, a_line_index, l_position, l_pla.m_inputs);
+        }
+
+        if (l_keyword == ".o")
+        {
+            uint32_t l_outputs = 0;
+
+            if (std::optional<line_error> l_error = read_count(a_line, a_line_index, l_position, l_outputs))
+                return l_error;
+
+            a_reader.m_outputs_given = true;
+            a_reader.m_sets.assign(l_outputs, {});
+
+            return std::nullopt;
+
+        }
+
+        if (l_keyword == ".ilb")
+            return read_labels(a_line, a_line_index, l_position, a_reader.m_inputs_given, l_pla.m_inputs, l_pla.m_input_labels);
+
+        if (l_keyword == ".ob")
+            return read_labels(a_line, a_line_index, l_position, a_reader.m_outputs_given, a_reader.m_sets.size(), l_pla.m_output_labels);
+
+        if (l_keyword == ".type")
+        {
+            const std::string_view l_type = next_word(a_line, l_position);
+
+            if (l_type != "f" && l_type != "fd" && l_type != "fr" && l_type != "fdr")
+                return fail(a_line_index, l_type.data() - a_line.data(), "unsupported .type");
+
+            a_reader.m_specified[PLA_ON] = true;
+            a_reader.m_specified[PLA_DONT_CARE] = l_type.find('d') != std::string_view::npos;
+            a_reader.m_specified[PLA_OFF] = l_type.find('r') != std::string_view::npos;
+
+            return std::nullopt;
+
+        }
+
+        if (l_keyword == ".e" || l_keyword == ".end")
+            a_reader.m_ended = true;
+
+        /// .p is only a hint, and the remaining directives
+        ///     (.phase, .pair, .mv, ...) do not apply.
+        return std::nullopt;
+
+    }
+
+    static std::optional<line_error> read_cube(
+        pla_reader& a_reader,
+        std::string_view a_line,
+        size_t a_line_index
+    )
+    {
+        pla& l_pla = a_reader.m_pla;
+
+        if (!a_reader.m_inputs_given || !a_reader.m_outputs_given)
+            return fail(a_line_index, 0, "cube precedes .i and .o");
+
+        const size_t l_width = l_pla.m_inputs + a_reader.m_sets.size();
+
+        /// Planes may be separated, or split, by whitespace and '|'.
+        a_reader.m_cube.clear();
+
+        for (size_t i = 0; i < a_line.size(); i++)
+        {
+            if (is_blank(a_line[i]) || a_line[i] == '|')
+                continue;
+
+            if (a_reader.m_cube.size() == l_width)
+                return fail(a_line_index, i, "cube is too wide");
+
+            const char l_char = a_line[i];
+
+            /// Each plane has its own alphabet, with '2' for '-'.
+            const bool l_valid = a_reader.m_cube.size() < l_pla.m_inputs ?
+                l_char == '0' || l_char == '1' || l_char == '-' || l_char == '2' :
+                l_char == '0' || l_char == '1' || l_char == '-' || l_char == '2' || l_char == '~' || l_char == '3' || l_char == '4';
+
+            if (!l_valid)
+                return fail(a_line_index, i, "unexpected character in cube");
+
+            a_reader.m_cube.push_back(l_char == '2' ? '-' : l_char);
+
+        }
+
+        if (a_reader.m_cube.size() != l_width)
+            return fail(a_line_index, a_line.size(), "cube is too narrow");
+
+        a_reader.m_planes.append(a_reader.m_cube, 0, l_pla.m_inputs);
+
+        for (size_t k = 0; k < a_reader.m_sets.size(); k++)
+        {
+            pla_set l_set;
+
+            switch (a_reader.m_cube[l_pla.m_inputs + k])
+            {
+                case '1': case '4': { l_set = PLA_ON; break; }
+                case '-':           { l_set = PLA_DONT_CARE; break; }
+                case '0': case '3': { l_set = PLA_OFF; break; }
+                default:            { continue; }
+            }
+
+            if (a_reader.m_specified[l_set])
+                a_reader.m_sets[k][l_set].push_back(a_reader.m_cubes);
+
+        }
+
+        a_reader.m_cubes++;
+
+        return std::nullopt;
+
+    }
+
+    static std::optional<line_error> read_line(
+        pla_reader& a_reader,
+        std::string_view a_line,
+        size_t a_line_index
+    )
+    {
+        size_t l_first = 0;
+
+        while (l_first < a_line.size() && is_blank(a_line[l_first]))
+            l_first++;
+
+        if (l_first == a_line.size() || a_line[l_first] == '#')
+            return std::nullopt;
+
+        if (a_line[l_first] == '.')
+            return read_directive(a_reader, a_line, a_line_index);
+
+        return read_cube(a_reader, a_line, a_line_index);
+
+    }
+
+    std::optional<line_error> read_pla(
+        std::istream& a_istream,
+        pla& a_pla,
+        size_t a_buffer_bytes
+    )
+    {
+        a_pla = pla{ 0 };
+
+        pla_reader l_reader{ a_pla, false, false, false, { true, true, false } };
+
+        line_reader l_lines(a_istream, a_buffer_bytes);
+
+        for (std::string_view l_line; !l_reader.m_ended && l_lines.next(l_line);)
+            if (std::optional<line_error> l_error = read_line(l_reader, l_line, l_lines.lines() - 1))
+                return l_error;
+
+        if (!l_reader.m_inputs_given || !l_reader.m_outputs_given)
+            return fail(l_lines.lines(), 0, "missing .i or .o");
+
+        /// The planes are complete, so views of them stay valid.
+        std::vector<std::string_view> l_planes;
+
+        l_planes.reserve(l_reader.m_cubes);
+
+        for (uint32_t i = 0; i < l_reader.m_cubes; i++)
+            l_planes.emplace_back(l_reader.m_planes.data() + size_t(i) * a_pla.m_inputs, a_pla.m_inputs);
+
+        std::vector<std::string_view> l_cubes;
+
+        const auto l_from_cubes = [&](const std::vector<uint32_t>& a_indices)
+        {
+            l_cubes.clear();
+
+            for (uint32_t l_index : a_indices)
+                l_cubes.push_back(l_planes[l_index]);
+
+            return from_cubes(l_cubes);
+        };
+
+        for (const std::array<std::vector<uint32_t>, 3>& l_sets : l_reader.m_sets)
+        {
+            const node* l_on = l_from_cubes(l_sets[PLA_ON]);
+            const node* l_dont_care = l_from_cubes(l_sets[PLA_DONT_CARE]);
+
+            /// Minterms left unspecified by an off-set are don't-cares.
+            if (l_reader.m_specified[PLA_OFF])
+                l_dont_care = logic::disjoin(l_dont_care, logic::invert(logic::disjoin(l_on, l_from_cubes(l_sets[PLA_OFF]))));
+
+            if (l_dont_care != ZERO)
+                l_dont_care = logic::conjoin(l_dont_care, logic::invert(l_on));
+
+            a_pla.m_on.push_back(l_on);
+            a_pla.m_dont_care.push_back(l_dont_care);
+
+        }
+
+        return std::nullopt;
+
+    }
+
+    /// The operations the cover construction applies.
+    enum isop_operation : uint8_t
+    {
+        ISOP_AND,
+        ISOP_OR,
+        ISOP_AND_NOT,
+    };
+
+    struct isop_operands
+    {
+        isop_operation m_operation;
+        const node* m_x;
+        const node* m_y;
+
+        bool operator==(
+            const isop_operands& a_other
+        ) const = default;
+
+    };
+
+    struct isop_operands_hash
+    {
+        size_t operator()(
+            const isop_operands& a_operands
+        ) const
+        {
+            return
+                (a_operands.m_operation * 0x9E3779B97F4A7C15ULL ^ (size_t)a_operands.m_x) * 0x100000001B3ULL ^
+                (size_t)a_operands.m_y;
+        }
+
+    };
+
+    /// A cover as found by irredundant_cover: the cubes of the
+    ///     negative cover with input m_depth complemented, then
+    ///     those of the positive cover with it uncomplemented,
+    ///     then those of the shared cover, each cover being
+    ///     referred to by index. Covers are linked rather than
+    ///     copied, so each step costs the same however many
+    ///     cubes lie beneath it.
+    struct isop_cover
+    {
+        uint32_t m_depth;
+        uint32_t m_negative;
+        uint32_t m_positive;
+        uint32_t m_shared;
+
+    };
+
+    struct isop_state
+    {
+        /// Defines the covers found so far. The first two
+        ///     are the empty cover and the cover of the one
+        ///     universal cube, and have no links.
+        std::vector<isop_cover> m_covers;
+
+        /// Maps each interval solved so far to the function
+        ///     of its cover and the index of the cover.
+        std::map<std::pair<const node*, const node*>, std::pair<const node*, uint32_t>> m_cache;
+
+        /// Shared by every step, since the steps apply
+        ///     operations to overlapping cofactors.
+        std::unordered_map<isop_operands, const node*, isop_operands_hash> m_applied;
+
+    };
+
+    static constexpr uint32_t EMPTY_COVER = 0;
+    static constexpr uint32_t UNIVERSAL_COVER = 1;
+
+    static const node* cofactor(
+        const node* a_node,
+        uint32_t a_depth,
+        bool a_value
+    )
+    {
+        if (a_node == ZERO || a_node == ONE || a_node->depth() != a_depth)
+            return a_node;
+
+        return a_value ? a_node->positive() : a_node->negative();
+
+    }
+
+    /// Applies the argued operation in one pass, so that
+    ///     x y' needs no inversion of y.
+    static const node* apply(
+        isop_state& a_state,
+        isop_operation a_operation,
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        switch (a_operation)
+        {
+            case ISOP_AND:
+            {
+                if (a_x == ZERO || a_y == ZERO)
+                    return ZERO;
+                if (a_x == ONE || a_x == a_y)
+                    return a_y;
+                if (a_y == ONE)
+                    return a_x;
+                break;
+            }
+            case ISOP_OR:
+            {
+                if (a_x == ONE || a_y == ONE)
+                    return ONE;
+                if (a_x == ZERO || a_x == a_y)
+                    return a_y;
+                if (a_y == ZERO)
+                    return a_x;
+                break;
+            }
+            case ISOP_AND_NOT:
+            {
+                if (a_x == ZERO || a_y == ONE || a_x == a_y)
+                    return ZERO;
+                if (a_y == ZERO)
+                    return a_x;
+                break;
+            }
+        }
+
+        /// Conjunction and disjunction commute, so
+        ///     their operands share one entry.
+        if (a_operation != ISOP_AND_NOT && a_y < a_x)
+            std::swap(a_x, a_y);
+
+        const isop_operands l_key = { a_operation, a_x, a_y };
+
+        const auto l_applied = a_state.m_applied.find(l_key);
+
+        if (l_applied != a_state.m_applied.end())
+            return l_applied->second;
+
+        /// At least one operand is a node, as the
+        ///     constant cases are decided above.
+        const uint32_t l_depth = std::min(
+            a_x == ZERO || a_x == ONE ? UINT32_MAX : a_x->depth(),
+            a_y == ZERO || a_y == ONE ? UINT32_MAX : a_y->depth()
+        );
+
+        const node* l_result = global_node_sink::bound()->emplace(
+            l_depth,
+            apply(a_state, a_operation, cofactor(a_x, l_depth, false), cofactor(a_y, l_depth, false)),
+            apply(a_state, a_operation, cofactor(a_x, l_depth, true), cofactor(a_y, l_depth, true))
+        );
+
+        return a_state.m_applied[l_key] = l_result;
+
+    }
+
+    /// Computes an irredundant sum of products covering a_lower
+    ///     and contained in a_upper, as Minato and Morreale do:
+    ///     the cubes needing the top variable complemented, those
+    ///     needing it uncomplemented, and then those free of it
+    ///     covering whatever the first two left over. Returns the
+    ///     function of the cover and the index of the cover.
+    static std::pair<const node*, uint32_t> irredundant_cover(
+        isop_state& a_state,
+        const node* a_lower,
+        const node* a_upper
+    )
+    {
+        if (a_lower == ZERO)
+            return { ZERO, EMPTY_COVER };
+        if (a_upper == ONE)
+            return { ONE, UNIVERSAL_COVER };
+
+        const auto l_cached = a_state.m_cache.find({ a_lower, a_upper });
+
+        if (l_cached != a_state.m_cache.end())
+            return l_cached->second;
+
+        /// a_lower is not ZERO and implies a_upper, so
+        ///     neither is a constant here.
+        const uint32_t l_depth = std::min(a_lower->depth(), a_upper->depth());
+
+        const node* l_lower_negative = cofactor(a_lower, l_depth, false);
+        const node* l_lower_positive = cofactor(a_lower, l_depth, true);
+        const node* l_upper_negative = cofactor(a_upper, l_depth, false);
+        const node* l_upper_positive = cofactor(a_upper, l_depth, true);
+
+        const auto [l_negative, l_negative_cover] = irredundant_cover(
+            a_state,
+            apply(a_state, ISOP_AND_NOT, l_lower_negative, l_upper_positive),
+            l_upper_negative
+        );
+
+        const auto [l_positive, l_positive_cover] = irredundant_cover(
+            a_state,
+            apply(a_state, ISOP_AND_NOT, l_lower_positive, l_upper_negative),
+            l_upper_positive
+        );
+
+        const auto [l_shared, l_shared_cover] = irredundant_cover(
+            a_state,
+            apply(
+                a_state,
+                ISOP_OR,
+                apply(a_state, ISOP_AND_NOT, l_lower_negative, l_negative),
+                apply(a_state, ISOP_AND_NOT, l_lower_positive, l_positive)
+            ),
+            apply(a_state, ISOP_AND, l_upper_negative, l_upper_positive)
+        );
+
+        a_state.m_covers.push_back({ l_depth, l_negative_cover, l_positive_cover, l_shared_cover });
+
+        const std::pair<const node*, uint32_t> l_result = {
+            global_node_sink::bound()->emplace(
+                l_depth,
+                apply(a_state, ISOP_OR, l_negative, l_shared),
+                apply(a_state, ISOP_OR, l_positive, l_shared)
+            ),
+            uint32_t(a_state.m_covers.size() - 1)
+        };
+
+        return a_state.m_cache[{ a_lower, a_upper }] = l_result;
+
+    }
+
+    /// Appends the cubes of the argued cover to a_cubes, a_cube
+    ///     holding the inputs fixed by the covers above it.
+    static void append_cubes(
+        const isop_state& a_state,
+        uint32_t a_cover_index,
+        std::string& a_cube,
+        std::vector<std::string>& a_cubes
+    )
+    {
+        if (a_cover_index == EMPTY_COVER)
+            return;
+
+        if (a_cover_index == UNIVERSAL_COVER)
+        {
+            a_cubes.push_back(a_cube);
+            return;
+        }
+
+        const isop_cover& l_cover = a_state.m_covers[a_cover_index];
+
+        a_cube[l_cover.m_depth] = '0';
+        append_cubes(a_state, l_cover.m_negative, a_cube, a_cubes);
+
+        a_cube[l_cover.m_depth] = '1';
+        append_cubes(a_state, l_cover.m_positive, a_cube, a_cubes);
+
+        a_cube[l_cover.m_depth] = '-';
+        append_cubes(a_state, l_cover.m_shared, a_cube, a_cubes);
+
+    }
+
+    std::vector<std::string> cover_output(
+        const pla& a_pla,
+        size_t a_output
+    )
+    {
+        const node* l_on = a_pla.m_on[a_output];
+        const node* l_dont_care = a_pla.m_dont_care[a_output];
+
+        if (a_pla.m_inputs <= TRUTH_TABLE_64_VARIABLES)
+        {
+            std::vector<std::string> l_cover;
+
+            for (const implicant& l_term : minimize_64(l_on, l_dont_care))
+            {
+                std::string& l_cube = l_cover.emplace_back(a_pla.m_inputs, '-');
+
+                for (uint32_t v = 0; v < a_pla.m_inputs; v++)
+                    if (l_term.care() & (1 << v))
+                        l_cube[v] = l_term.value() & (1 << v) ? '1' : '0';
+            }
+
+            return l_cover;
+
+        }
+
+        isop_state l_state{ { {}, {} } };
+
+        const uint32_t l_cover_index = irredundant_cover(l_state, l_on, apply(l_state, ISOP_OR, l_on, l_dont_care)).second;
+
+        /// Only the final cover is spelled out.
+        std::vector<std::string> l_cubes;
+        std::string l_cube(a_pla.m_inputs, '-');
+
+        append_cubes(l_state, l_cover_index, l_cube, l_cubes);
+
+        return l_cubes;
+
+    }
+
+    std::ostream& write_pla(
+        std::ostream& a_ostream,
+        const pla& a_pla
+    )
+    {
+        const size_t l_outputs = a_pla.m_on.size();
+
+        /// Lines by input plane, each holding both planes,
+        ///     so cubes shared between outputs are merged.
+        std::vector<std::string> l_lines;
+        std::unordered_map<std::string, size_t> l_line_indices;
+
+        for (size_t k = 0; k < l_outputs; k++)
+            for (std::string& l_cube : cover_output(a_pla, k))
+            {
+                const auto [l_entry, l_inserted] = l_line_indices.try_emplace(std::move(l_cube), l_lines.size());
+
+                if (l_inserted)
+                    l_lines.push_back(l_entry->first + " " + std::string(l_outputs, '0'));
+
+                l_lines[l_entry->second][a_pla.m_inputs + 1 + k] = '1';
+
+            }
+
+        std::string l_buffer;
+
+        l_buffer.reserve(PLA_BUFFER_BYTES);
+
+        const auto l_flush = [&](size_t a_threshold)
+        {
+            if (l_buffer.size() < a_threshold)
+                return;
+
+            a_ostream.write(l_buffer.data(), l_buffer.size());
+            l_buffer.clear();
+        };
+
+        l_buffer += ".i " + std::to_string(a_pla.m_inputs) + "\n";
+        l_buffer += ".o " + std::to_string(l_outputs) + "\n";
+
+        for (const auto& [l_keyword, l_labels] : { std::make_pair(".ilb", &a_pla.m_input_labels), std::make_pair(".ob", &a_pla.m_output_labels) })
+        {
+            if (l_labels->empty())
+                continue;
+
+            l_buffer += l_keyword;
+
+            for (const std::string& l_label : *l_labels)
+                l_buffer += " " + l_label;
+
+            l_buffer += "\n";
+
+        }
+
+        l_buffer += ".p " + std::to_string(l_lines.size()) + "\n";
+
+        for (const std::string& l_line : l_lines)
+        {
+            l_buffer += l_line;
+            l_buffer += '\n';
+
+            l_flush(PLA_BUFFER_BYTES);
+
+        }
+
+        l_buffer += ".e\n";
+
+        l_flush(0);
+
+        return a_ostream;
+
+    }
+
+}
@@ -0,0 +1,860 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <unordered_map>
+
+#include "include/serialize.h"
+
+namespace factor
+{
+    static constexpr char BINARY_MAGIC[4] = { 'F', 'D', 'A', 'G' };
+    static constexpr char CHECKPOINT_MAGIC[4] = { 'F', 'C', 'K', 'P' };
+    static constexpr uint8_t BINARY_VERSION = 1;
+
+    /// Text pending for a stream, written a chunk at a time.
+    struct binary_writer
+    {
+        std::ostream& m_ostream;
+        std::string m_buffer;
+
+    };
+
+    static void flush(
+        binary_writer& a_writer,
+        size_t a_threshold
+    )
+    {
+        if (a_writer.m_buffer.size() < a_threshold)
+            return;
+
+        a_writer.m_ostream.write(a_writer.m_buffer.data(), a_writer.m_buffer.size());
+        a_writer.m_buffer.clear();
+    }
+
+    static void append_varint(
+        std::string& a_text,
+        uint64_t a_value
+    )
+    {
+        while (a_value >= 0x80)
+        {
+            a_text += char(a_value | 0x80);
+            a_value >>= 7;
+        }
+
+        a_text += char(a_value);
+    }
+
+    /// Returns the code of a_node, as referred to from the
+    ///     node numbered a_from, or from the root table if
+    ///     a_from is UINT64_MAX.
+    static uint64_t child_code(
+        const node* a_node,
+        const std::unordered_map<const node*, uint64_t>& a_indices,
+        uint64_t a_from
+    )
+    {
+        if (a_node == ZERO)
+            return 0;
+        if (a_node == ONE)
+            return 1;
+
+        const uint64_t l_index = a_indices.at(a_node);
+
+        return a_from == UINT64_MAX ? l_index + 2 : a_from - l_index + 1;
+    }
+
+    /// Appends the counts, the names of the variables below
+    ///     a_names_end, the levels and the roots, the argued
+    ///     nodes being numbered by a_indices, deepest first.
+    static void append_dag(
+        binary_writer& a_writer,
+        const std::vector<const node*>& a_nodes,
+        const std::unordered_map<const node*, uint64_t>& a_indices,
+        std::span<const node* const> a_roots,
+        const symbol_table& a_symbols,
+        uint32_t a_names_end
+    )
+    {
+        std::string& l_buffer = a_writer.m_buffer;
+
+        size_t l_levels = 0;
+
+        for (size_t i = 0; i < a_nodes.size(); i++)
+            if (i == 0 || a_nodes[i]->depth() != a_nodes[i - 1]->depth())
+                l_levels++;
+
+        std::vector<std::pair<uint32_t, std::string_view>> l_names;
+
+        for (uint32_t v = 0; v < a_names_end; v++)
+            if (const std::string_view l_name = a_symbols.name(v); !l_name.empty())
+                l_names.emplace_back(v, l_name);
+
+        append_varint(l_buffer, a_nodes.size());
+        append_varint(l_buffer, l_levels);
+        append_varint(l_buffer, a_roots.size());
+        append_varint(l_buffer, l_names.size());
+
+        for (const auto& [l_variable_index, l_name] : l_names)
+        {
+            append_varint(l_buffer, l_variable_index);
+            append_varint(l_buffer, l_name.size());
+            l_buffer += l_name;
+
+            flush(a_writer, SERIALIZE_BUFFER_BYTES);
+        }
+
+        for (size_t l_begin = 0; l_begin < a_nodes.size();)
+        {
+            const uint32_t l_depth = a_nodes[l_begin]->depth();
+
+            size_t l_end = l_begin;
+
+            while (l_end < a_nodes.size() && a_nodes[l_end]->depth() == l_depth)
+                l_end++;
+
+            append_varint(l_buffer, l_begin == 0 ? l_depth : a_nodes[l_begin - 1]->depth() - l_depth);
+            append_varint(l_buffer, l_end - l_begin);
+
+            for (size_t i = l_begin; i < l_end; i++)
+            {
+                append_varint(l_buffer, child_code(a_nodes[i]->negative(), a_indices, i));
+                append_varint(l_buffer, child_code(a_nodes[i]->positive(), a_indices, i));
+
+                flush(a_writer, SERIALIZE_BUFFER_BYTES);
+            }
+
+            l_begin = l_end;
+
+        }
+
+        for (const node* l_root : a_roots)
+            append_varint(l_buffer, child_code(l_root, a_indices, UINT64_MAX));
+
+    }
+
+    std::ostream& write_binary(
+        std::ostream& a_ostream,
+        std::span<const node* const> a_roots
+    )
+    {
+        dag* l_dag = global_node_sink::bound();
+
+        /// Gather the nodes, each once.
+        std::vector<const node*> l_nodes;
+
+        {
+            const uint32_t l_epoch = l_dag->next_epoch();
+
+            std::vector<const node*> l_pending(a_roots.begin(), a_roots.end());
+
+            while (!l_pending.empty())
+            {
+                const node* l_node = l_pending.back();
+
+                l_pending.pop_back();
+
+                if (l_node == ZERO || l_node == ONE || !l_node->mark(l_epoch))
+                    continue;
+
+                l_nodes.push_back(l_node);
+
+                l_pending.push_back(l_node->positive());
+                l_pending.push_back(l_node->negative());
+            }
+        }
+
+        std::stable_sort(
+            l_nodes.begin(),
+            l_nodes.end(),
+            [](const node* a_x, const node* a_y) { return a_x->depth() > a_y->depth(); }
+        );
+
+        std::unordered_map<const node*, uint64_t> l_indices;
+
+        l_indices.reserve(l_nodes.size());
+
+        for (size_t i = 0; i < l_nodes.size(); i++)
+            l_indices.emplace(l_nodes[i], i);
+
+        binary_writer l_writer{ a_ostream };
+
+        l_writer.m_buffer.reserve(SERIALIZE_BUFFER_BYTES);
+
+        l_writer.m_buffer.append(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        l_writer.m_buffer += char(BINARY_VERSION);
+
+        /// Only the names of the variables written are kept.
+        append_dag(
+            l_writer,
+            l_nodes,
+            l_indices,
+            a_roots,
+            l_dag->symbols(),
+            l_nodes.empty() ? 0 : l_nodes.front()->depth() + 1
+        );
+
+        flush(l_writer, 0);
+
+        return a_ostream;
+
+    }
+
+    std::ostream& write_checkpoint(
+        std::ostream& a_ostream,
+        const dag& a_dag,
+        std::span<const node* const> a_roots,
+        const checkpoint_tables& a_tables
+    )
+    {
+        std::vector<const node*> l_nodes;
+
+        l_nodes.reserve(a_dag.size());
+
+        a_dag.for_each_node([&](const node* a_node) { l_nodes.push_back(a_node); });
+
+        std::unordered_map<const node*, uint64_t> l_indices;
+
+        l_indices.reserve(l_nodes.size());
+
+        const auto l_code = [&](const node* a_node) { return child_code(a_node, l_indices, UINT64_MAX); };
+
+        /// Within each level, nodes are ordered by the numbers
+        ///     of their children, already given as the children
+        ///     lie deeper, so the numbering depends only on the
+        ///     structure of the dag and not on where its nodes
+        ///     happen to be allocated.
+        std::vector<std::tuple<uint64_t, uint64_t, const node*>> l_level;
+
+        for (size_t l_begin = 0; l_begin < l_nodes.size();)
+        {
+            size_t l_end = l_begin;
+
+            while (l_end < l_nodes.size() && l_nodes[l_end]->depth() == l_nodes[l_begin]->depth())
+                l_end++;
+
+            l_level.clear();
+
+            for (size_t i = l_begin; i < l_end; i++)
+                l_level.emplace_back(l_code(l_nodes[i]->negative()), l_code(l_nodes[i]->positive()), l_nodes[i]);
+
+            std::sort(l_level.begin(), l_level.end());
+
+            for (size_t i = l_begin; i < l_end; i++)
+            {
+                l_nodes[i] = std::get<2>(l_level[i - l_begin]);
+                l_indices.emplace(l_nodes[i], i);
+            }
+
+            l_begin = l_end;
+
+        }
+
+        binary_writer l_writer{ a_ostream };
+
+        l_writer.m_buffer.reserve(SERIALIZE_BUFFER_BYTES);
+
+        std::string& l_buffer = l_writer.m_buffer;
+
+        l_buffer.append(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        l_buffer += char(BINARY_VERSION);
+
+        append_dag(l_writer, l_nodes, l_indices, a_roots, a_dag.symbols(), a_dag.symbols().extent());
+
+        /// Entries are written in the order of their codes
+        ///     rather than of the tables' pointer keys.
+        append_varint(l_buffer, a_tables.m_joins.size());
+
+        for (const std::map<std::set<const node*>, const node*>* l_table : a_tables.m_joins)
+        {
+            std::vector<std::pair<std::vector<uint64_t>, uint64_t>> l_entries;
+
+            l_entries.reserve(l_table->size());
+
+            for (const auto& [l_operands, l_result] : *l_table)
+            {
+                std::vector<uint64_t> l_operand_codes;
+
+                for (const node* l_operand : l_operands)
+                    l_operand_codes.push_back(l_code(l_operand));
+
+                std::sort(l_operand_codes.begin(), l_operand_codes.end());
+
+                l_entries.emplace_back(std::move(l_operand_codes), l_code(l_result));
+            }
+
+            std::sort(l_entries.begin(), l_entries.end());
+
+            append_varint(l_buffer, l_entries.size());
+
+            for (const auto& [l_operand_codes, l_result_code] : l_entries)
+            {
+                append_varint(l_buffer, l_operand_codes.size());
+
+                for (uint64_t l_operand_code : l_operand_codes)
+                    append_varint(l_buffer, l_operand_code);
+
+                append_varint(l_buffer, l_result_code);
+
+                flush(l_writer, SERIALIZE_BUFFER_BYTES);
+            }
+        }
+
+        append_varint(l_buffer, a_tables.m_inversions.size());
+
+        for (const std::map<const node*, const node*>* l_table : a_tables.m_inversions)
+        {
+            std::vector<std::pair<uint64_t, uint64_t>> l_entries;
+
+            l_entries.reserve(l_table->size());
+
+            for (const auto& [l_operand, l_result] : *l_table)
+                l_entries.emplace_back(l_code(l_operand), l_code(l_result));
+
+            std::sort(l_entries.begin(), l_entries.end());
+
+            append_varint(l_buffer, l_entries.size());
+
+            for (const auto& [l_operand_code, l_result_code] : l_entries)
+            {
+                append_varint(l_buffer, l_operand_code);
+                append_varint(l_buffer, l_result_code);
+
+                flush(l_writer, SERIALIZE_BUFFER_BYTES);
+            }
+        }
+
+        flush(l_writer, 0);
+
+        return a_ostream;
+
+    }
+
+    /// Flushes the file or directory at a_path to disk.
+    static void sync(
+        const std::string& a_path,
+        int a_flags
+    )
+    {
+        const int l_file = open(a_path.c_str(), a_flags);
+
+        if (l_file < 0 || fsync(l_file) != 0)
+        {
+            const int l_errno = errno;
+
+            if (l_file >= 0)
+                close(l_file);
+
+            throw std::system_error(l_errno, std::generic_category(), a_path);
+        }
+
+        close(l_file);
+
+    }
+
+    void save_checkpoint(
+        const char* a_path,
+        const dag& a_dag,
+        std::span<const node* const> a_roots,
+        const checkpoint_tables& a_tables
+    )
+    {
+        const std::string l_temporary = std::string(a_path) + ".tmp";
+
+        try
+        {
+            /// Streams do not report why they fail, so
+            ///     their failures are reported as EIO.
+            {
+                std::ofstream l_file(l_temporary, std::ios::binary | std::ios::trunc);
+
+                if (!l_file)
+                    throw std::system_error(EIO, std::generic_category(), l_temporary);
+
+                write_checkpoint(l_file, a_dag, a_roots, a_tables);
+
+                l_file.close();
+
+                if (!l_file)
+                    throw std::system_error(EIO, std::generic_category(), l_temporary);
+            }
+
+            /// The data must be on disk before the rename makes it
+            ///     the checkpoint, or a crash could leave neither.
+            sync(l_temporary, O_RDONLY);
+
+            std::filesystem::rename(l_temporary, a_path);
+        }
+        catch (...)
+        {
+            std::error_code l_error;
+
+            std::filesystem::remove(l_temporary, l_error);
+
+            throw;
+        }
+
+        /// The rename is only durable once the
+        ///     directory holding it is on disk.
+        const std::filesystem::path l_directory = std::filesystem::path(a_path).parent_path();
+
+        sync(l_directory.empty() ? std::string(".") : l_directory.string(), O_RDONLY | O_DIRECTORY);
+
+    }
+
+    /// Reads a stream a block at a time, tracking
+    ///     the offset of the next byte.
+    struct binary_reader
+    {
+        std::istream& m_istream;
+        std::vector<char> m_buffer;
+
+        /// Defines the unread bytes of the block.
+        const char* m_next;
+        const char* m_end;
+
+        /// Defines the offset of the block in the stream.
+        size_t m_offset;
+
+        /// Defines the offset of the last item read,
+        ///     at which errors are reported.
+        size_t m_item;
+
+    };
+
+    static size_t position(
+        const binary_reader& a_reader
+    )
+    {
+        return a_reader.m_offset + (a_reader.m_next - a_reader.m_buffer.data());
+    }
+
+    /// Reads the next block, returning false at the end.
+    static bool refill(
+        binary_reader& a_reader
+    )
+    {
+        a_reader.m_offset = position(a_reader);
+
+        a_reader.m_istream.read(a_reader.m_buffer.data(), a_reader.m_buffer.size());
+
+        a_reader.m_next = a_reader.m_buffer.data();
+        a_reader.m_end = a_reader.m_next + a_reader.m_istream.gcount();
+
+        return a_reader.m_next != a_reader.m_end;
+    }
+
+    static bool read_varint(
+        binary_reader& a_reader,
+        uint64_t& a_value
+    )
+    {
+        a_reader.m_item = position(a_reader);
+
+        a_value = 0;
+
+        for (uint32_t l_shift = 0; l_shift < 64; l_shift += 7)
+        {
+            if (a_reader.m_next == a_reader.m_end && !refill(a_reader))
+                return false;
+
+            const uint8_t l_byte = *a_reader.m_next++;
+
+            a_value |= uint64_t(l_byte & 0x7F) << l_shift;
+
+            if (!(l_byte & 0x80))
+                return true;
+        }
+
+        /// Longer than any 64-bit value.
+        return false;
+
+    }
+
+    static bool read_bytes(
+        binary_reader& a_reader,
+        std::string& a_bytes,
+        size_t a_count
+    )
+    {
+        a_bytes.clear();
+
+        while (a_bytes.size() < a_count)
+        {
+            if (a_reader.m_next == a_reader.m_end && !refill(a_reader))
+                return false;
+
+            const size_t l_count = std::min<size_t>(a_count - a_bytes.size(), a_reader.m_end - a_reader.m_next);
+
+            a_bytes.append(a_reader.m_next, l_count);
+            a_reader.m_next += l_count;
+        }
+
+        return true;
+
+    }
+
+    static parse_error fail(
+        const binary_reader& a_reader,
+        std::string_view a_message
+    )
+    {
+        return { a_reader.m_item, a_message };
+    }
+
+    /// Reads the argued magic and the version.
+    static std::optional<parse_error> read_magic(
+        binary_reader& a_reader,
+        const char (&a_magic)[4],
+        std::string_view a_message
+    )
+    {
+        std::string l_bytes;
+
+        a_reader.m_item = 0;
+
+        if (!read_bytes(a_reader, l_bytes, sizeof(a_magic) + 1) ||
+            std::memcmp(l_bytes.data(), a_magic, sizeof(a_magic)) != 0)
+            return fail(a_reader, a_message);
+
+        a_reader.m_item = sizeof(a_magic);
+
+        if (uint8_t(l_bytes.back()) != BINARY_VERSION)
+            return fail(a_reader, "unsupported version");
+
+        return std::nullopt;
+
+    }
+
+    /// Reads a node referred to by its number, as from the root
+    ///     table, a_built giving the node of each number, and
+    ///     failing with a_message if there is no such node.
+    static std::optional<parse_error> read_node(
+        binary_reader& a_reader,
+        const std::vector<const node*>& a_built,
+        const node*& a_node,
+        std::string_view a_message
+    )
+    {
+        uint64_t l_code;
+
+        if (!read_varint(a_reader, l_code))
+            return fail(a_reader, "truncated node reference");
+
+        if (l_code < 2)
+            a_node = l_code == 0 ? ZERO : ONE;
+        else if (l_code - 2 < a_built.size())
+            a_node = a_built[l_code - 2];
+        else
+            return fail(a_reader, a_message);
+
+        return std::nullopt;
+
+    }
+
+    /// Assigns names read by read_dag into the bound dag's
+    ///     symbol table, once the data holding them is whole.
+    static void assign_names(
+        const std::vector<std::pair<uint32_t, std::string>>& a_names
+    )
+    {
+        symbol_table& l_symbols = global_node_sink::bound()->symbols();
+
+        for (const auto& [l_variable_index, l_name] : a_names)
+            l_symbols.assign(l_name, l_variable_index);
+
+    }
+
+    /// Reads the section appended by append_dag into the bound
+    ///     dag, setting a_built to the node of each number. The
+    ///     names are checked against the symbol table and each
+    ///     other but only returned in a_names, so that malformed
+    ///     data leaves the symbol table as it was.
+    static std::optional<parse_error> read_dag(
+        binary_reader& a_reader,
+        std::vector<const node*>& a_built,
+        std::vector<const node*>& a_roots,
+        std::vector<std::pair<uint32_t, std::string>>& a_names
+    )
+    {
+        dag* l_dag = global_node_sink::bound();
+
+        uint64_t l_node_count;
+        uint64_t l_level_count;
+        uint64_t l_root_count;
+        uint64_t l_name_count;
+
+        if (!read_varint(a_reader, l_node_count) || !read_varint(a_reader, l_level_count) ||
+            !read_varint(a_reader, l_root_count) || !read_varint(a_reader, l_name_count))
+            return fail(a_reader, "truncated header");
+
+        std::string l_bytes;
+
+        /// The names read so far, each way round.
+        std::unordered_map<uint32_t, std::string> l_names;
+        std::unordered_map<std::string, uint32_t> l_indices;
+
+        a_names.clear();
+        a_names.reserve(std::min<uint64_t>(l_name_count, SERIALIZE_BUFFER_BYTES));
+
+        for (uint64_t i = 0; i < l_name_count; i++)
+        {
+            uint64_t l_variable_index;
+            uint64_t l_length;
+
+            if (!read_varint(a_reader, l_variable_index) || !read_varint(a_reader, l_length) ||
+                !read_bytes(a_reader, l_bytes, l_length))
+                return fail(a_reader, "truncated name");
+
+            if (l_variable_index > UINT32_MAX)
+                return fail(a_reader, "variable index out of range");
+
+            const std::string_view l_bound_name = l_dag->symbols().name(l_variable_index);
+            const std::optional<uint32_t> l_bound_index = l_dag->symbols().find(l_bytes);
+
+            if ((!l_bound_name.empty() && l_bound_name != l_bytes) ||
+                (l_bound_index && *l_bound_index != l_variable_index))
+                return fail(a_reader, "conflicting variable name");
+
+            const auto l_name = l_names.find(l_variable_index);
+            const auto l_index = l_indices.find(l_bytes);
+
+            if ((l_name != l_names.end() && l_name->second != l_bytes) ||
+                (l_index != l_indices.end() && l_index->second != l_variable_index))
+                return fail(a_reader, "conflicting variable name");
+
+            if (l_name != l_names.end())
+                continue;
+
+            l_names.emplace(l_variable_index, l_bytes);
+            l_indices.emplace(l_bytes, l_variable_index);
+
+            a_names.emplace_back(l_variable_index, l_bytes);
+        }
+
+        a_built.clear();
+        a_built.reserve(std::min<uint64_t>(l_node_count, SERIALIZE_BUFFER_BYTES));
+
+        uint64_t l_depth = 0;
+
+        for (uint64_t l_level = 0; l_level < l_level_count; l_level++)
+        {
+            uint64_t l_step;
+            uint64_t l_count;
+
+            if (!read_varint(a_reader, l_step))
+                return fail(a_reader, "truncated level");
+
+            /// Levels rise strictly, so every child
+            ///     lies deeper than its parent.
+            if (l_level == 0 ? l_step > UINT32_MAX : l_step == 0 || l_step > l_depth)
+                return fail(a_reader, "level out of order");
+
+            l_depth = l_level == 0 ? l_step : l_depth - l_step;
+
+            if (!read_varint(a_reader, l_count))
+                return fail(a_reader, "truncated level");
+
+            if (l_count > l_node_count - a_built.size())
+                return fail(a_reader, "more nodes than declared");
+
+            const uint64_t l_level_begin = a_built.size();
+
+            for (uint64_t k = 0; k < l_count; k++)
+            {
+                const uint64_t l_index = a_built.size();
+
+                const node* l_children[2];
+
+                for (const node*& l_child : l_children)
+                {
+                    uint64_t l_code;
+
+                    if (!read_varint(a_reader, l_code))
+                        return fail(a_reader, "truncated node");
+
+                    if (l_code < 2)
+                    {
+                        l_child = l_code == 0 ? ZERO : ONE;
+                        continue;
+                    }
+
+                    /// The child must lie on a deeper level.
+                    if (l_code - 1 > l_index || l_index - (l_code - 1) >= l_level_begin)
+                        return fail(a_reader, "child out of range");
+
+                    l_child = a_built[l_index - (l_code - 1)];
+                }
+
+                a_built.push_back(l_dag->emplace(l_depth, l_children[0], l_children[1]));
+            }
+        }
+
+        if (a_built.size() != l_node_count)
+            return fail(a_reader, "fewer nodes than declared");
+
+        a_roots.clear();
+        a_roots.reserve(std::min<uint64_t>(l_root_count, SERIALIZE_BUFFER_BYTES));
+
+        for (uint64_t i = 0; i < l_root_count; i++)
+        {
+            const node* l_root;
+
+            if (std::optional<parse_error> l_error = read_node(a_reader, a_built, l_root, "root out of range"))
+                return l_error;
+
+            a_roots.push_back(l_root);
+        }
+
+        return std::nullopt;
+
+    }
+
+    std::optional<parse_error> read_binary(
+        std::istream& a_istream,
+        std::vector<const node*>& a_roots,
+        size_t a_buffer_bytes
+    )
+    {
+        binary_reader l_reader{ a_istream, std::vector<char>(std::max<size_t>(a_buffer_bytes, 1)) };
+
+        l_reader.m_next = l_reader.m_end = l_reader.m_buffer.data();
+        l_reader.m_offset = 0;
+
+        if (std::optional<parse_error> l_error = read_magic(l_reader, BINARY_MAGIC, "expected \"FDAG\""))
+            return l_error;
+
+        std::vector<const node*> l_built;
+        std::vector<std::pair<uint32_t, std::string>> l_names;
+
+        if (std::optional<parse_error> l_error = read_dag(l_reader, l_built, a_roots, l_names))
+            return l_error;
+
+        assign_names(l_names);
+
+        return std::nullopt;
+
+    }
+
+    std::optional<parse_error> read_checkpoint(
+        std::istream& a_istream,
+        std::vector<const node*>& a_roots,
+        const checkpoint_tables& a_tables,
+        size_t a_buffer_bytes
+    )
+    {
+        binary_reader l_reader{ a_istream, std::vector<char>(std::max<size_t>(a_buffer_bytes, 1)) };
+
+        l_reader.m_next = l_reader.m_end = l_reader.m_buffer.data();
+        l_reader.m_offset = 0;
+
+        if (std::optional<parse_error> l_error = read_magic(l_reader, CHECKPOINT_MAGIC, "expected \"FCKP\""))
+            return l_error;
+
+        std::vector<const node*> l_built;
+        std::vector<std::pair<uint32_t, std::string>> l_names;
+
+        if (std::optional<parse_error> l_error = read_dag(l_reader, l_built, a_roots, l_names))
+            return l_error;
+
+        uint64_t l_table_count;
+        uint64_t l_entry_count;
+
+        if (!read_varint(l_reader, l_table_count))
+            return fail(l_reader, "truncated tables");
+
+        if (l_table_count != a_tables.m_joins.size())
+            return fail(l_reader, "join table count differs");
+
+        for (std::map<std::set<const node*>, const node*>* l_table : a_tables.m_joins)
+        {
+            if (!read_varint(l_reader, l_entry_count))
+                return fail(l_reader, "truncated tables");
+
+            for (uint64_t i = 0; i < l_entry_count; i++)
+            {
+                uint64_t l_operand_count;
+
+                if (!read_varint(l_reader, l_operand_count))
+                    return fail(l_reader, "truncated tables");
+
+                if (l_operand_count > l_built.size() + 2)
+                    return fail(l_reader, "too many operands");
+
+                std::set<const node*> l_operands;
+
+                for (uint64_t k = 0; k < l_operand_count; k++)
+                {
+                    const node* l_operand;
+
+                    if (std::optional<parse_error> l_error = read_node(l_reader, l_built, l_operand, "table entry out of range"))
+                        return l_error;
+
+                    l_operands.insert(l_operand);
+                }
+
+                const node* l_result;
+
+                if (std::optional<parse_error> l_error = read_node(l_reader, l_built, l_result, "table entry out of range"))
+                    return l_error;
+
+                l_table->insert_or_assign(std::move(l_operands), l_result);
+            }
+        }
+
+        if (!read_varint(l_reader, l_table_count))
+            return fail(l_reader, "truncated tables");
+
+        if (l_table_count != a_tables.m_inversions.size())
+            return fail(l_reader, "inversion table count differs");
+
+        for (std::map<const node*, const node*>* l_table : a_tables.m_inversions)
+        {
+            if (!read_varint(l_reader, l_entry_count))
+                return fail(l_reader, "truncated tables");
+
+            for (uint64_t i = 0; i < l_entry_count; i++)
+            {
+                const node* l_operand;
+                const node* l_result;
+
+                if (std::optional<parse_error> l_error = read_node(l_reader, l_built, l_operand, "table entry out of range"))
+                    return l_error;
+
+                if (std::optional<parse_error> l_error = read_node(l_reader, l_built, l_result, "table entry out of range"))
+                    return l_error;
+
+                l_table->insert_or_assign(l_operand, l_result);
+            }
+        }
+
+        assign_names(l_names);
+
+        return std::nullopt;
+
+    }
+
+    std::optional<parse_error> load_checkpoint(
+        const char* a_path,
+        std::vector<const node*>& a_roots,
+        const checkpoint_tables& a_tables
+    )
+    {
+        std::ifstream l_file(a_path, std::ios::binary);
+
+        if (!l_file)
+            throw std::system_error(errno, std::generic_category(), a_path);
+
+        return read_checkpoint(l_file, a_roots, a_tables);
+
+    }
+
+}
@@ -0,0 +1,163 @@
+#include <charconv>
+
+#include "include/writer.h"
+
+namespace factor
+{
+    expression_writer::expression_writer(
+        std::ostream& a_ostream,
+        size_t a_buffer_bytes
+    ) :
+        m_ostream(a_ostream),
+        m_symbols(nullptr),
+        m_buffer_bytes(a_buffer_bytes)
+    {
+        m_buffer.reserve(a_buffer_bytes);
+    }
+
+    expression_writer::expression_writer(
+        std::ostream& a_ostream,
+        const symbol_table& a_symbols,
+        size_t a_buffer_bytes
+    ) :
+        expression_writer(a_ostream, a_buffer_bytes)
+    {
+        m_symbols = &a_symbols;
+    }
+
+    expression_writer::~expression_writer(
+
+    )
+    {
+        flush();
+    }
+
+    bool expression_writer::write_variable(
+        uint32_t a_variable_index
+    )
+    {
+        if (m_symbols)
+        {
+            const std::string_view l_name = m_symbols->name(a_variable_index);
+
+            if (!l_name.empty())
+            {
+                m_buffer.append(l_name);
+                return true;
+            }
+        }
+
+        /// Large enough for any 32-bit index and its brackets.
+        char l_digits[12];
+
+        l_digits[0] = '[';
+
+        char* l_end = std::to_chars(l_digits + 1, l_digits + sizeof(l_digits), a_variable_index).ptr;
+
+        *l_end++ = ']';
+
+        m_buffer.append(l_digits, l_end);
+
+        return false;
+
+    }
+
+    expression_writer& expression_writer::write(
+        const node* a_node
+    )
+    {
+        m_stack.push_back({ a_node, 0 });
+
+        while (!m_stack.empty())
+        {
+            if (m_buffer.size() >= m_buffer_bytes)
+                flush();
+
+            const node* l_node = m_stack.back().m_node;
+
+            /// Base cases are not written.
+            if (l_node == ZERO || l_node == ONE)
+            {
+                m_stack.pop_back();
+                continue;
+            }
+
+            /// Bounding parens and the disjunction are only
+            ///     written if BOTH children are non-zero.
+            const bool l_both = l_node->negative() != ZERO && l_node->positive() != ZERO;
+
+            switch (m_stack.back().m_stage++)
+            {
+                case 0:
+                {
+                    if (l_both)
+                        m_buffer += '(';
+
+                    if (l_node->negative() != ZERO)
+                    {
+                        write_variable(l_node->depth());
+                        m_buffer += '\'';
+                        m_stack.push_back({ l_node->negative(), 0 });
+                    }
+
+                    break;
+
+                }
+                case 1:
+                {
+                    if (l_both)
+                        m_buffer += '+';
+
+                    if (l_node->positive() != ZERO)
+                    {
+                        /// A name directly followed by another name or
+                        ///     an index would read back as one name.
+                        if (write_variable(l_node->depth()) && l_node->positive() != ONE)
+                            m_buffer += ' ';
+
+                        m_stack.push_back({ l_node->positive(), 0 });
+                    }
+
+                    break;
+
+                }
+                default:
+                {
+                    if (l_both)
+                        m_buffer += ')';
+
+                    m_stack.pop_back();
+
+                    break;
+
+                }
+            }
+
+        }
+
+        return *this;
+
+    }
+
+    expression_writer& expression_writer::write(
+        std::string_view a_text
+    )
+    {
+        m_buffer.append(a_text);
+
+        if (m_buffer.size() >= m_buffer_bytes)
+            flush();
+
+        return *this;
+
+    }
+
+    void expression_writer::flush(
+
+    )
+    {
+        m_ostream.write(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+    }
+
+}